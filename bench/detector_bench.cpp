@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Micro-benchmark for the drop detector core: drives synthetic samples through
+// drop_detector_tick() and reports ns/tick and heap allocations/tick.
+#include "core/drop_detector.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// ------------------------ Allocation counting ------------------------
+static std::atomic<uint64_t> g_allocs{0};
+
+void *operator new(size_t size)
+{
+	g_allocs.fetch_add(1, std::memory_order_relaxed);
+	if (void *p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+// ------------------------ Synthetic streams ------------------------
+struct Scenario {
+	const char *name;
+	uint32_t drop_every;   // ticks between drop bursts (0 = never)
+	uint32_t burst_frames; // dropped frames per burst
+	uint32_t sample_every; // ticks between fresh samples (sampler slower than render)
+	uint32_t reset_every;  // ticks between counter resets (0 = never)
+	bool all_signals;      // also feed encoder skips and render lag
+	bool adaptive;         // learned thresholds instead of the fixed one
+};
+
+static const Scenario kScenarios[] = {
+	{"steady", 0, 0, 1, 0, false, false},
+	{"bursty", 240, 12, 1, 0, false, false},
+	{"sampled/6", 240, 12, 6, 0, false, false},
+	{"resets", 97, 3, 1, 5000, false, false},
+	{"3-signals", 240, 12, 1, 0, true, false},
+	{"adaptive", 240, 12, 1, 0, false, true},
+};
+
+// Small xorshift so drop bursts do not line up with the sample period
+static inline uint32_t next_rand(uint32_t *state)
+{
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return *state = x;
+}
+
+static void run_scenario(const Scenario &sc, uint64_t ticks)
+{
+	DropDetectorConfig cfg;
+	cfg.signal_enabled[DROP_CAUSE_ENCODER] = sc.all_signals;
+	cfg.signal_enabled[DROP_CAUSE_RENDER] = sc.all_signals;
+	cfg.adaptive = sc.adaptive;
+
+	DropDetector det;
+	DropSample sample;
+	sample.active = true;
+
+	const float frame_sec = 1.0f / 144.0f;
+	const uint64_t frame_ns = 1000000000ULL / 144;
+	uint32_t rng = 0x9e3779b9u;
+	uint64_t visible_ticks = 0;
+
+	const uint64_t allocs_before = g_allocs.load(std::memory_order_relaxed);
+	const auto start = std::chrono::steady_clock::now();
+
+	for (uint64_t i = 0; i < ticks; i++) {
+		sample.fresh = (i % sc.sample_every) == 0;
+		if (sample.fresh) {
+			sample.timestamp_ns = i * frame_ns;
+			const int signals = sc.all_signals ? DROP_CAUSE_COUNT : 1;
+			for (int c = 0; c < signals; c++) {
+				FrameCounters &fc = sample.counters[c];
+				fc.total += sc.sample_every;
+				if (sc.drop_every && (next_rand(&rng) % sc.drop_every) == 0)
+					fc.dropped += sc.burst_frames;
+				if (sc.reset_every && (i % sc.reset_every) == 0)
+					fc.total = fc.dropped = 0;
+			}
+		}
+		drop_detector_tick(&det, &cfg, &sample, frame_sec);
+		visible_ticks += det.auto_visible || det.stable_visible;
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	const uint64_t allocs = g_allocs.load(std::memory_order_relaxed) - allocs_before;
+	const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+	printf("%-14s %12llu %10.2f %12.6f %9.1f%%\n", sc.name, (unsigned long long)ticks, ns / (double)ticks,
+	       (double)allocs / (double)ticks, (double)visible_ticks * 100.0 / (double)ticks);
+}
+
+int main(int argc, char **argv)
+{
+	uint64_t ticks = 10000000;
+	if (argc > 1)
+		ticks = strtoull(argv[1], nullptr, 10);
+	if (ticks == 0)
+		ticks = 1;
+
+	printf("%-14s %12s %10s %12s %10s\n", "scenario", "ticks", "ns/tick", "allocs/tick", "visible");
+	for (const Scenario &sc : kScenarios)
+		run_scenario(sc, ticks);
+	return 0;
+}
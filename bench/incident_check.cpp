@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// ctest check of the incident tracker: two dropping episodes with a quiet stretch between
+// them, during which the tracker is not fed (as the plugin does), must each count only the
+// frames sent during the episode itself.
+#include "core/incident_log.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+struct Stream {
+	DropSample sample;
+	uint64_t timestamp_ns = 1000000000ull;
+};
+
+// One fresh sample: 6 frames sent, dropped of them lost
+static const DropSample *send(Stream *s, uint64_t dropped)
+{
+	s->timestamp_ns += 100000000ull;
+	s->sample.active = true;
+	s->sample.fresh = true;
+	s->sample.timestamp_ns = s->timestamp_ns;
+	s->sample.counters[DROP_CAUSE_NETWORK].total += 6;
+	s->sample.counters[DROP_CAUSE_NETWORK].dropped += dropped;
+	return &s->sample;
+}
+
+// Feed an episode of samples; the first one opens the record and sets the baseline
+static uint64_t episode(IncidentTracker *t, IncidentLog *log, Stream *s, int samples)
+{
+	DropDetector d;
+	d.auto_visible = true;
+	d.cause = DROP_CAUSE_NETWORK;
+	d.signals[DROP_CAUSE_NETWORK].pct = 16.7;
+	for (int i = 0; i < samples; i++)
+		incident_tracker_tick(t, log, incident_kind(&d), &d, send(s, 1), "streaming", "check");
+	const uint64_t seq = t->seq;
+	d.auto_visible = false;
+	incident_tracker_tick(t, log, incident_kind(&d), &d, send(s, 0), "streaming", "check");
+	return seq;
+}
+
+static bool expect(const IncidentRecord *rec, uint64_t dropped, uint64_t total, const char *what)
+{
+	if (rec && rec->dropped_frames == dropped && rec->total_frames == total && rec->end_ms)
+		return true;
+	fprintf(stderr, "FAIL: %s: expected %llu/%llu, logged %llu/%llu\n", what, (unsigned long long)dropped,
+		(unsigned long long)total, rec ? (unsigned long long)rec->dropped_frames : 0ull,
+		rec ? (unsigned long long)rec->total_frames : 0ull);
+	return false;
+}
+
+int main(void)
+{
+	const std::string path = (std::filesystem::temp_directory_path() / "online-status-incident-check.bin").string();
+	std::filesystem::remove(path);
+	IncidentLog log;
+	if (!incident_log_open(&log, path.c_str())) {
+		fprintf(stderr, "FAIL: cannot open %s\n", path.c_str());
+		return 1;
+	}
+
+	IncidentTracker t;
+	Stream s;
+	const uint64_t first = episode(&t, &log, &s, 11);
+	for (int i = 0; i < 1000; i++)
+		send(&s, 0); // quiet: the tracker is not fed
+	const uint64_t second = episode(&t, &log, &s, 21);
+
+	bool ok = expect(incident_log_record(&log, first), 10, 60, "first episode");
+	ok = expect(incident_log_record(&log, second), 20, 120, "second episode") && ok;
+	incident_log_close(&log);
+	std::filesystem::remove(path);
+	if (ok)
+		printf("incident check passed\n");
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// ctest check of the metrics exporter against the libobs stand-in: a registered source has to
+// show up in the exported file with its series, and drop out while hidden (a linked member).
+#include <obs-stub.h>
+#include "online_status_metrics.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+static const char kSeries[] = "online_status_state_seconds_total{source=\"Check source\",state=\"ok\"}";
+
+// Export to a new file and return what the exporter wrote first
+static std::string export_once(const std::filesystem::path &path)
+{
+	std::filesystem::remove(path);
+	online_status_metrics_configure(METRICS_EXPORT_FILE, path.string().c_str());
+	for (int i = 0; i < 200 && !std::filesystem::exists(path); i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	online_status_metrics_configure(METRICS_EXPORT_OFF, nullptr);
+	std::ifstream in(path, std::ios::binary);
+	std::stringstream text;
+	text << in.rdbuf();
+	return text.str();
+}
+
+static bool check(bool ok, const char *what, const std::string &text)
+{
+	if (!ok)
+		fprintf(stderr, "FAIL: %s\n--- export ---\n%s\n", what, text.c_str());
+	return ok;
+}
+
+int main(void)
+{
+	const std::filesystem::path dir = std::filesystem::temp_directory_path();
+	SourceMetrics *m = online_status_metrics_register("Check source");
+	DropDetector det;
+	DropDetectorConfig cfg;
+	online_status_metrics_tick(m, &det, &cfg, true, 0.5f, 1000);
+
+	bool ok = true;
+	std::string text = export_once(dir / "online-status-metrics-check-1.prom");
+	ok = check(text.find(kSeries) != std::string::npos, "registered source has no series", text) && ok;
+
+	online_status_metrics_hide(m);
+	text = export_once(dir / "online-status-metrics-check-2.prom");
+	ok = check(text.find("Check source") == std::string::npos, "hidden source is exported", text) && ok;
+	ok = check(text.find("# TYPE online_status_state_seconds_total") != std::string::npos, "headers missing",
+		   text) && ok;
+
+	online_status_metrics_tick(m, &det, &cfg, true, 0.5f, 1000);
+	text = export_once(dir / "online-status-metrics-check-3.prom");
+	ok = check(text.find(kSeries) != std::string::npos, "source not back after its next tick", text) && ok;
+
+	online_status_metrics_unregister(m);
+	online_status_metrics_stop();
+	if (ok)
+		printf("metrics check passed\n");
+	return ok ? 0 : 1;
+}
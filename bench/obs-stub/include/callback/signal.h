@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct calldata calldata_t;
+typedef struct signal_handler signal_handler_t;
+typedef void (*signal_callback_t)(void *data, calldata_t *cd);
+
+void signal_handler_connect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data);
+void signal_handler_disconnect(signal_handler_t *handler, const char *signal, signal_callback_t callback,
+			       void *data);
+void signal_handler_signal(signal_handler_t *handler, const char *signal, calldata_t *params);
+
+const char *calldata_string(const calldata_t *data, const char *name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "graphics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct gif_frame {
+	int frame_delay;
+} gif_frame;
+
+typedef struct gif_animation {
+	unsigned int frame_count;
+	gif_frame *frames;
+} gif_animation;
+
+struct gs_image_file {
+	gs_texture_t *texture;
+	uint32_t cx;
+	uint32_t cy;
+	bool is_animated_gif;
+	bool loaded;
+	gif_animation gif;
+	uint8_t **animation_frame_cache;
+	int cur_frame;
+};
+typedef struct gs_image_file gs_image_file_t;
+
+void gs_image_file_init(gs_image_file_t *image, const char *file);
+void gs_image_file_free(gs_image_file_t *image);
+void gs_image_file_init_texture(gs_image_file_t *image);
+bool gs_image_file_tick(gs_image_file_t *image, uint64_t elapsed_time_ns);
+
+#ifdef __cplusplus
+}
+#endif
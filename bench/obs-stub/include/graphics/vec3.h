@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+struct vec3 {
+	float x, y, z, w;
+};
+
+static inline void vec3_set(struct vec3 *dst, float x, float y, float z)
+{
+	dst->x = x;
+	dst->y = y;
+	dst->z = z;
+	dst->w = 0.0f;
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAX_AV_PLANES 8
+
+enum audio_format {
+	AUDIO_FORMAT_UNKNOWN,
+	AUDIO_FORMAT_U8BIT,
+	AUDIO_FORMAT_16BIT,
+	AUDIO_FORMAT_32BIT,
+	AUDIO_FORMAT_FLOAT,
+	AUDIO_FORMAT_U8BIT_PLANAR,
+	AUDIO_FORMAT_16BIT_PLANAR,
+	AUDIO_FORMAT_32BIT_PLANAR,
+	AUDIO_FORMAT_FLOAT_PLANAR,
+};
+
+enum speaker_layout { SPEAKERS_UNKNOWN, SPEAKERS_MONO, SPEAKERS_STEREO };
+
+#ifdef __cplusplus
+}
+#endif
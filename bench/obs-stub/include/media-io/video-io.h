@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct video_output video_t;
+
+uint32_t video_output_get_skipped_frames(const video_t *video);
+uint32_t video_output_get_total_frames(const video_t *video);
+
+#ifdef __cplusplus
+}
+#endif
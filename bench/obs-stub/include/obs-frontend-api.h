@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <obs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum obs_frontend_event {
+	OBS_FRONTEND_EVENT_STREAMING_STARTING,
+	OBS_FRONTEND_EVENT_STREAMING_STARTED,
+	OBS_FRONTEND_EVENT_STREAMING_STOPPING,
+	OBS_FRONTEND_EVENT_STREAMING_STOPPED,
+	OBS_FRONTEND_EVENT_EXIT,
+};
+
+typedef void (*obs_frontend_event_cb)(enum obs_frontend_event event, void *private_data);
+
+void obs_frontend_add_event_callback(obs_frontend_event_cb callback, void *private_data);
+void obs_frontend_remove_event_callback(obs_frontend_event_cb callback, void *private_data);
+obs_output_t *obs_frontend_get_streaming_output(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "obs.h"
+
+#define OBS_DECLARE_MODULE()
+#define OBS_MODULE_USE_DEFAULT_LOCALE(db_name, default_locale)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Paths below the stub's data and config directories (bfree the result)
+char *obs_module_file(const char *file);
+char *obs_module_config_path(const char *file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Controls of the stand-in that real libobs does not have; used by the benchmarks to play
+// the part of OBS (frontend events, output counters, graphics work done).
+#include <obs-frontend-api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fire a frontend event at every registered callback
+void obs_stub_frontend_event(enum obs_frontend_event event);
+
+// The streaming output; frames and drops only move when the benchmark adds them
+obs_output_t *obs_stub_streaming_output(void);
+void obs_stub_output_set_active(obs_output_t *output, bool active);
+void obs_stub_output_add_frames(obs_output_t *output, uint32_t total, uint32_t dropped);
+
+// Graphics calls the plugin made, to report what a frame would cost the GPU
+struct obs_stub_gs_counters {
+	uint64_t draws;         // gs_draw_sprite and gs_draw
+	uint64_t texrenders;    // gs_texrender_begin
+	uint64_t child_renders; // obs_source_video_render of text/image children
+};
+void obs_stub_get_gs_counters(struct obs_stub_gs_counters *out);
+
+#ifdef __cplusplus
+}
+#endif
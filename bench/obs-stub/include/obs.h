@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Stand-in for libobs, just enough for the plugin sources (see bench/obs-stub/obs_stub.cpp)
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "util/c99defs.h"
+#include "util/base.h"
+#include "util/bmem.h"
+#include "callback/signal.h"
+#include "graphics/graphics.h"
+#include "media-io/audio-io.h"
+#include "media-io/video-io.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct obs_source obs_source_t;
+typedef struct obs_output obs_output_t;
+typedef struct obs_weak_output obs_weak_output_t;
+typedef struct obs_data obs_data_t;
+typedef struct obs_properties obs_properties_t;
+typedef struct obs_property obs_property_t;
+
+// ------------------------ Source types ------------------------
+enum obs_source_type { OBS_SOURCE_TYPE_INPUT, OBS_SOURCE_TYPE_FILTER, OBS_SOURCE_TYPE_TRANSITION };
+
+#define OBS_SOURCE_VIDEO (1 << 0)
+#define OBS_SOURCE_AUDIO (1 << 1)
+
+enum obs_base_effect { OBS_EFFECT_DEFAULT, OBS_EFFECT_SOLID, OBS_EFFECT_PREMULTIPLIED_ALPHA };
+
+struct obs_source_info {
+	const char *id;
+	enum obs_source_type type;
+	uint32_t output_flags;
+	const char *(*get_name)(void *type_data);
+	void *(*create)(obs_data_t *settings, obs_source_t *source);
+	void (*destroy)(void *data);
+	uint32_t (*get_width)(void *data);
+	uint32_t (*get_height)(void *data);
+	void (*get_defaults)(obs_data_t *settings);
+	obs_properties_t *(*get_properties)(void *data);
+	void (*update)(void *data, obs_data_t *settings);
+	void (*video_tick)(void *data, float seconds);
+	void (*video_render)(void *data, gs_effect_t *effect);
+};
+
+void obs_register_source_s(const struct obs_source_info *info, size_t size);
+#define obs_register_source(info) obs_register_source_s(info, sizeof(struct obs_source_info))
+
+// ------------------------ Settings ------------------------
+obs_data_t *obs_data_create(void);
+void obs_data_release(obs_data_t *data);
+void obs_data_set_string(obs_data_t *data, const char *name, const char *val);
+void obs_data_set_int(obs_data_t *data, const char *name, long long val);
+void obs_data_set_double(obs_data_t *data, const char *name, double val);
+void obs_data_set_bool(obs_data_t *data, const char *name, bool val);
+void obs_data_set_default_string(obs_data_t *data, const char *name, const char *val);
+void obs_data_set_default_int(obs_data_t *data, const char *name, long long val);
+void obs_data_set_default_double(obs_data_t *data, const char *name, double val);
+void obs_data_set_default_bool(obs_data_t *data, const char *name, bool val);
+const char *obs_data_get_string(obs_data_t *data, const char *name);
+long long obs_data_get_int(obs_data_t *data, const char *name);
+double obs_data_get_double(obs_data_t *data, const char *name);
+bool obs_data_get_bool(obs_data_t *data, const char *name);
+bool obs_data_has_user_value(obs_data_t *data, const char *name);
+
+// ------------------------ Properties (inert) ------------------------
+enum obs_combo_type { OBS_COMBO_TYPE_INVALID, OBS_COMBO_TYPE_EDITABLE, OBS_COMBO_TYPE_LIST };
+enum obs_combo_format { OBS_COMBO_FORMAT_INVALID, OBS_COMBO_FORMAT_INT, OBS_COMBO_FORMAT_FLOAT };
+enum obs_text_type { OBS_TEXT_DEFAULT, OBS_TEXT_PASSWORD, OBS_TEXT_MULTILINE };
+enum obs_path_type { OBS_PATH_FILE, OBS_PATH_FILE_SAVE, OBS_PATH_DIRECTORY };
+enum obs_group_type { OBS_COMBO_INVALID, OBS_GROUP_NORMAL, OBS_GROUP_CHECKABLE };
+
+typedef bool (*obs_property_clicked_t)(obs_properties_t *props, obs_property_t *property, void *data);
+typedef bool (*obs_property_modified_t)(obs_properties_t *props, obs_property_t *property, obs_data_t *settings);
+
+obs_properties_t *obs_properties_create(void);
+obs_property_t *obs_properties_get(obs_properties_t *props, const char *property);
+obs_property_t *obs_properties_add_bool(obs_properties_t *props, const char *name, const char *description);
+obs_property_t *obs_properties_add_int(obs_properties_t *props, const char *name, const char *description, int min,
+				       int max, int step);
+obs_property_t *obs_properties_add_int_slider(obs_properties_t *props, const char *name, const char *description,
+					      int min, int max, int step);
+obs_property_t *obs_properties_add_float_slider(obs_properties_t *props, const char *name, const char *description,
+						double min, double max, double step);
+obs_property_t *obs_properties_add_text(obs_properties_t *props, const char *name, const char *description,
+					enum obs_text_type type);
+obs_property_t *obs_properties_add_path(obs_properties_t *props, const char *name, const char *description,
+					enum obs_path_type type, const char *filter, const char *default_path);
+obs_property_t *obs_properties_add_list(obs_properties_t *props, const char *name, const char *description,
+					enum obs_combo_type type, enum obs_combo_format format);
+obs_property_t *obs_properties_add_button(obs_properties_t *props, const char *name, const char *text,
+					  obs_property_clicked_t callback);
+obs_property_t *obs_properties_add_group(obs_properties_t *props, const char *name, const char *description,
+					 enum obs_group_type type, obs_properties_t *group);
+obs_properties_t *obs_property_group_content(obs_property_t *p);
+size_t obs_property_list_add_int(obs_property_t *p, const char *name, long long val);
+void obs_property_set_visible(obs_property_t *p, bool visible);
+void obs_property_set_modified_callback(obs_property_t *p, obs_property_modified_t modified);
+void obs_property_float_set_suffix(obs_property_t *p, const char *suffix);
+void obs_property_int_set_suffix(obs_property_t *p, const char *suffix);
+
+// ------------------------ Sources ------------------------
+obs_source_t *obs_source_create_private(const char *id, const char *name, obs_data_t *settings);
+obs_source_t *obs_source_get_ref(obs_source_t *source);
+void obs_source_release(obs_source_t *source);
+void obs_source_update(obs_source_t *source, obs_data_t *settings);
+void obs_source_set_enabled(obs_source_t *source, bool enabled);
+uint32_t obs_source_get_width(obs_source_t *source);
+uint32_t obs_source_get_height(obs_source_t *source);
+void obs_source_video_tick(obs_source_t *source, float seconds);
+void obs_source_video_render(obs_source_t *source);
+
+struct obs_source_audio {
+	const uint8_t *data[MAX_AV_PLANES];
+	uint32_t frames;
+	enum speaker_layout speakers;
+	enum audio_format format;
+	uint32_t samples_per_sec;
+	uint64_t timestamp;
+};
+void obs_source_output_audio(obs_source_t *source, const struct obs_source_audio *audio);
+const char *obs_source_get_name(const obs_source_t *source);
+uint32_t obs_source_get_output_flags(const obs_source_t *source);
+bool obs_source_active(const obs_source_t *source);
+signal_handler_t *obs_source_get_signal_handler(const obs_source_t *source);
+gs_effect_t *obs_get_base_effect(enum obs_base_effect effect);
+
+// ------------------------ Outputs ------------------------
+bool obs_output_active(const obs_output_t *output);
+void obs_output_release(obs_output_t *output);
+obs_weak_output_t *obs_output_get_weak_output(obs_output_t *output);
+obs_output_t *obs_weak_output_get_output(obs_weak_output_t *weak);
+void obs_weak_output_release(obs_weak_output_t *weak);
+bool obs_weak_output_references_output(obs_weak_output_t *weak, obs_output_t *output);
+int obs_output_get_frames_dropped(const obs_output_t *output);
+int obs_output_get_total_frames(const obs_output_t *output);
+uint64_t obs_output_get_total_bytes(const obs_output_t *output);
+float obs_output_get_congestion(obs_output_t *output);
+const char *obs_output_get_name(const obs_output_t *output);
+signal_handler_t *obs_output_get_signal_handler(const obs_output_t *output);
+void obs_enum_outputs(bool (*enum_proc)(void *, obs_output_t *), void *param);
+
+// ------------------------ Pipeline ------------------------
+uint32_t obs_get_lagged_frames(void);
+uint32_t obs_get_total_frames(void);
+video_t *obs_get_video(void);
+void obs_enter_graphics(void);
+void obs_leave_graphics(void);
+
+#ifdef __cplusplus
+}
+#endif
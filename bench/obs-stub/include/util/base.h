@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+	LOG_ERROR = 100,
+	LOG_WARNING = 200,
+	LOG_INFO = 300,
+	LOG_DEBUG = 400,
+};
+
+void blog(int log_level, const char *format, ...);
+void blogva(int log_level, const char *format, va_list args);
+
+#ifdef __cplusplus
+}
+#endif
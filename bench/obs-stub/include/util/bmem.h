@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *bmalloc(size_t size);
+void *bzalloc(size_t size);
+void bfree(void *ptr);
+char *bstrdup(const char *str);
+
+#ifdef __cplusplus
+}
+#endif
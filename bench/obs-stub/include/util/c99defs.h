@@ -0,0 +1,6 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Stand-in for libobs, just enough for the plugin sources (see bench/obs-stub/obs_stub.cpp)
+#pragma once
+
+#define UNUSED_PARAMETER(param) (void)param
+#define EXPORT
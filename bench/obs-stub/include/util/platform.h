@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t os_gettime_ns(void);
+int os_stat(const char *file, struct stat *st);
+FILE *os_fopen(const char *path, const char *mode);
+int os_mkdirs(const char *path);
+bool os_quick_write_utf8_file_safe(const char *path, const char *str, size_t len, bool marker, const char *temp_ext,
+				   const char *backup_ext);
+void os_set_thread_name(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
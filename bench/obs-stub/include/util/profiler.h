@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void profile_start(const char *name);
+void profile_end(const char *name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,889 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Stand-in for the parts of libobs and the frontend API the plugin calls. Sources, settings,
+// signals and one streaming output behave like the real thing as far as the plugin can
+// tell; graphics calls do nothing but count. Benchmarks only, never shipped.
+#include <obs-module.h>
+#include <obs-stub.h>
+#include <graphics/image-file.h>
+#include <util/platform.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef OBS_STUB_DATA_DIR
+#define OBS_STUB_DATA_DIR "data"
+#endif
+
+// ------------------------ Memory and logging ------------------------
+extern "C" void *bmalloc(size_t size)
+{
+	return malloc(size ? size : 1);
+}
+
+extern "C" void *bzalloc(size_t size)
+{
+	return calloc(1, size ? size : 1);
+}
+
+extern "C" void bfree(void *ptr)
+{
+	free(ptr);
+}
+
+extern "C" char *bstrdup(const char *str)
+{
+	if (!str)
+		return nullptr;
+	const size_t n = strlen(str) + 1;
+	auto *copy = static_cast<char *>(bmalloc(n));
+	memcpy(copy, str, n);
+	return copy;
+}
+
+// Only warnings and errors, so benchmark output stays readable
+extern "C" void blogva(int log_level, const char *format, va_list args)
+{
+	if (log_level > LOG_WARNING)
+		return;
+	vfprintf(stderr, format, args);
+	fputc('\n', stderr);
+}
+
+extern "C" void blog(int log_level, const char *format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	blogva(log_level, format, args);
+	va_end(args);
+}
+
+// ------------------------ Platform ------------------------
+extern "C" uint64_t os_gettime_ns(void)
+{
+	using namespace std::chrono;
+	return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+extern "C" int os_stat(const char *file, struct stat *st)
+{
+	return stat(file, st);
+}
+
+extern "C" FILE *os_fopen(const char *path, const char *mode)
+{
+	return fopen(path, mode);
+}
+
+extern "C" int os_mkdirs(const char *path)
+{
+	std::error_code ec;
+	std::filesystem::create_directories(path, ec);
+	return ec ? -1 : 0;
+}
+
+extern "C" bool os_quick_write_utf8_file_safe(const char *path, const char *str, size_t len, bool, const char *temp_ext,
+					      const char *)
+{
+	const std::string temp = std::string(path) + "." + (temp_ext ? temp_ext : "tmp");
+	{
+		std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+		if (!out.write(str, (std::streamsize)len))
+			return false;
+	}
+	std::error_code ec;
+	std::filesystem::rename(temp, path, ec);
+	return !ec;
+}
+
+extern "C" void os_set_thread_name(const char *) {}
+
+// The profiler is not modelled; scopes cost a call each, like an idle libobs profiler
+extern "C" void profile_start(const char *) {}
+
+extern "C" void profile_end(const char *) {}
+
+extern "C" char *obs_module_file(const char *file)
+{
+	return bstrdup((std::string(OBS_STUB_DATA_DIR) + "/" + file).c_str());
+}
+
+extern "C" char *obs_module_config_path(const char *file)
+{
+	const std::filesystem::path dir = std::filesystem::temp_directory_path() / "online-status-stub";
+	return bstrdup((dir / file).string().c_str());
+}
+
+// ------------------------ Signals ------------------------
+struct calldata {
+	std::map<std::string, std::string> strings;
+};
+
+struct signal_handler {
+	struct Slot {
+		std::string signal;
+		signal_callback_t callback;
+		void *data;
+	};
+	std::mutex mutex;
+	std::vector<Slot> slots;
+};
+
+extern "C" void signal_handler_connect(signal_handler_t *handler, const char *signal, signal_callback_t callback,
+				       void *data)
+{
+	std::lock_guard<std::mutex> lock(handler->mutex);
+	handler->slots.push_back({signal, callback, data});
+}
+
+extern "C" void signal_handler_disconnect(signal_handler_t *handler, const char *signal, signal_callback_t callback,
+					  void *data)
+{
+	std::lock_guard<std::mutex> lock(handler->mutex);
+	for (auto it = handler->slots.begin(); it != handler->slots.end(); ++it) {
+		if (it->signal == signal && it->callback == callback && it->data == data) {
+			handler->slots.erase(it);
+			return;
+		}
+	}
+}
+
+extern "C" void signal_handler_signal(signal_handler_t *handler, const char *signal, calldata_t *params)
+{
+	std::vector<signal_handler::Slot> slots;
+	{
+		std::lock_guard<std::mutex> lock(handler->mutex);
+		slots = handler->slots;
+	}
+	for (const auto &slot : slots) {
+		if (slot.signal == signal)
+			slot.callback(slot.data, params);
+	}
+}
+
+extern "C" const char *calldata_string(const calldata_t *data, const char *name)
+{
+	auto it = data->strings.find(name);
+	return it != data->strings.end() ? it->second.c_str() : nullptr;
+}
+
+// ------------------------ Settings ------------------------
+struct DataValue {
+	std::string s;
+	long long i = 0;
+	double d = 0.0;
+	bool b = false;
+};
+
+struct DataItem {
+	bool has_user = false;
+	DataValue user;
+	DataValue def;
+
+	const DataValue &get() const { return has_user ? user : def; }
+};
+
+struct obs_data {
+	std::atomic<long> refs{1};
+	std::unordered_map<std::string, DataItem> items;
+};
+
+extern "C" obs_data_t *obs_data_create(void)
+{
+	return new obs_data();
+}
+
+static obs_data_t *data_addref(obs_data_t *data)
+{
+	data->refs.fetch_add(1, std::memory_order_relaxed);
+	return data;
+}
+
+extern "C" void obs_data_release(obs_data_t *data)
+{
+	if (data && data->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		delete data;
+}
+
+static DataValue *user_value(obs_data_t *data, const char *name)
+{
+	DataItem &item = data->items[name];
+	item.has_user = true;
+	return &item.user;
+}
+
+extern "C" void obs_data_set_string(obs_data_t *data, const char *name, const char *val)
+{
+	user_value(data, name)->s = val ? val : "";
+}
+
+extern "C" void obs_data_set_int(obs_data_t *data, const char *name, long long val)
+{
+	DataValue *v = user_value(data, name);
+	v->i = val;
+	v->d = (double)val;
+}
+
+extern "C" void obs_data_set_double(obs_data_t *data, const char *name, double val)
+{
+	DataValue *v = user_value(data, name);
+	v->d = val;
+	v->i = (long long)val;
+}
+
+extern "C" void obs_data_set_bool(obs_data_t *data, const char *name, bool val)
+{
+	user_value(data, name)->b = val;
+}
+
+extern "C" void obs_data_set_default_string(obs_data_t *data, const char *name, const char *val)
+{
+	data->items[name].def.s = val ? val : "";
+}
+
+extern "C" void obs_data_set_default_int(obs_data_t *data, const char *name, long long val)
+{
+	DataValue &v = data->items[name].def;
+	v.i = val;
+	v.d = (double)val;
+}
+
+extern "C" void obs_data_set_default_double(obs_data_t *data, const char *name, double val)
+{
+	DataValue &v = data->items[name].def;
+	v.d = val;
+	v.i = (long long)val;
+}
+
+extern "C" void obs_data_set_default_bool(obs_data_t *data, const char *name, bool val)
+{
+	data->items[name].def.b = val;
+}
+
+static const DataValue *find_value(obs_data_t *data, const char *name)
+{
+	auto it = data->items.find(name);
+	return it != data->items.end() ? &it->second.get() : nullptr;
+}
+
+extern "C" const char *obs_data_get_string(obs_data_t *data, const char *name)
+{
+	const DataValue *v = find_value(data, name);
+	return v ? v->s.c_str() : "";
+}
+
+extern "C" long long obs_data_get_int(obs_data_t *data, const char *name)
+{
+	const DataValue *v = find_value(data, name);
+	return v ? v->i : 0;
+}
+
+extern "C" double obs_data_get_double(obs_data_t *data, const char *name)
+{
+	const DataValue *v = find_value(data, name);
+	return v ? v->d : 0.0;
+}
+
+extern "C" bool obs_data_get_bool(obs_data_t *data, const char *name)
+{
+	const DataValue *v = find_value(data, name);
+	return v ? v->b : false;
+}
+
+extern "C" bool obs_data_has_user_value(obs_data_t *data, const char *name)
+{
+	auto it = data->items.find(name);
+	return it != data->items.end() && it->second.has_user;
+}
+
+// Copy the user values of src into dst (obs_source_update semantics)
+static void data_apply(obs_data_t *dst, obs_data_t *src)
+{
+	for (const auto &[name, item] : src->items) {
+		if (!item.has_user)
+			continue;
+		DataItem &target = dst->items[name];
+		target.has_user = true;
+		target.user = item.user;
+	}
+}
+
+// ------------------------ Properties (inert) ------------------------
+struct obs_properties {
+	int unused;
+};
+struct obs_property {
+	int unused;
+};
+static obs_property g_property;
+
+extern "C" obs_properties_t *obs_properties_create(void)
+{
+	return new obs_properties();
+}
+
+extern "C" obs_property_t *obs_properties_get(obs_properties_t *, const char *)
+{
+	return nullptr;
+}
+
+extern "C" obs_property_t *obs_properties_add_bool(obs_properties_t *, const char *, const char *)
+{
+	return &g_property;
+}
+
+extern "C" obs_property_t *obs_properties_add_int(obs_properties_t *, const char *, const char *, int, int, int)
+{
+	return &g_property;
+}
+
+extern "C" obs_property_t *obs_properties_add_int_slider(obs_properties_t *, const char *, const char *, int, int, int)
+{
+	return &g_property;
+}
+
+extern "C" obs_property_t *obs_properties_add_float_slider(obs_properties_t *, const char *, const char *, double,
+							   double, double)
+{
+	return &g_property;
+}
+
+extern "C" obs_property_t *obs_properties_add_text(obs_properties_t *, const char *, const char *, enum obs_text_type)
+{
+	return &g_property;
+}
+
+extern "C" obs_property_t *obs_properties_add_path(obs_properties_t *, const char *, const char *, enum obs_path_type,
+						   const char *, const char *)
+{
+	return &g_property;
+}
+
+extern "C" obs_property_t *obs_properties_add_list(obs_properties_t *, const char *, const char *,
+						   enum obs_combo_type, enum obs_combo_format)
+{
+	return &g_property;
+}
+
+extern "C" obs_property_t *obs_properties_add_button(obs_properties_t *, const char *, const char *,
+						     obs_property_clicked_t)
+{
+	return &g_property;
+}
+
+extern "C" obs_property_t *obs_properties_add_group(obs_properties_t *, const char *, const char *,
+						    enum obs_group_type, obs_properties_t *)
+{
+	return &g_property;
+}
+
+extern "C" obs_properties_t *obs_property_group_content(obs_property_t *)
+{
+	return nullptr;
+}
+
+extern "C" size_t obs_property_list_add_int(obs_property_t *, const char *, long long)
+{
+	return 0;
+}
+
+extern "C" void obs_property_set_visible(obs_property_t *, bool) {}
+extern "C" void obs_property_set_modified_callback(obs_property_t *, obs_property_modified_t) {}
+extern "C" void obs_property_float_set_suffix(obs_property_t *, const char *) {}
+extern "C" void obs_property_int_set_suffix(obs_property_t *, const char *) {}
+
+// ------------------------ Graphics (counting only) ------------------------
+struct gs_texture {
+	int unused;
+};
+struct gs_texture_render {
+	gs_texture texture;
+};
+struct gs_effect {
+	bool in_loop = false;
+};
+struct gs_effect_param {
+	int unused;
+};
+struct gs_vertex_buffer {
+	gs_vb_data *data;
+};
+
+static gs_effect g_base_effects[OBS_EFFECT_PREMULTIPLIED_ALPHA + 1];
+static gs_effect_param g_param;
+static std::atomic<uint64_t> g_draws{0};
+static std::atomic<uint64_t> g_texrenders{0};
+static std::atomic<uint64_t> g_child_renders{0};
+
+extern "C" gs_texrender_t *gs_texrender_create(enum gs_color_format, enum gs_zstencil_format)
+{
+	return new gs_texture_render();
+}
+
+extern "C" void gs_texrender_destroy(gs_texrender_t *texrender)
+{
+	delete texrender;
+}
+
+extern "C" bool gs_texrender_begin(gs_texrender_t *, uint32_t cx, uint32_t cy)
+{
+	g_texrenders.fetch_add(1, std::memory_order_relaxed);
+	return cx && cy;
+}
+
+extern "C" void gs_texrender_end(gs_texrender_t *) {}
+extern "C" void gs_texrender_reset(gs_texrender_t *) {}
+
+extern "C" gs_texture_t *gs_texrender_get_texture(const gs_texrender_t *texrender)
+{
+	return const_cast<gs_texture_t *>(&texrender->texture);
+}
+
+extern "C" gs_effect_t *gs_effect_create_from_file(const char *, char **error_string)
+{
+	if (error_string)
+		*error_string = nullptr;
+	return new gs_effect();
+}
+
+extern "C" void gs_effect_destroy(gs_effect_t *effect)
+{
+	delete effect;
+}
+
+extern "C" gs_eparam_t *gs_effect_get_param_by_name(const gs_effect_t *, const char *)
+{
+	return &g_param;
+}
+
+extern "C" void gs_effect_set_texture(gs_eparam_t *, gs_texture_t *) {}
+extern "C" void gs_effect_set_float(gs_eparam_t *, float) {}
+extern "C" void gs_effect_set_vec2(gs_eparam_t *, const struct vec2 *) {}
+extern "C" void gs_effect_set_vec4(gs_eparam_t *, const struct vec4 *) {}
+
+// One pass per technique, like the effects the plugin uses
+extern "C" bool gs_effect_loop(gs_effect_t *effect, const char *)
+{
+	effect->in_loop = !effect->in_loop;
+	return effect->in_loop;
+}
+
+extern "C" void gs_draw_sprite(gs_texture_t *, uint32_t, uint32_t, uint32_t)
+{
+	g_draws.fetch_add(1, std::memory_order_relaxed);
+}
+
+extern "C" void gs_draw_sprite_subregion(gs_texture_t *, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t)
+{
+	g_draws.fetch_add(1, std::memory_order_relaxed);
+}
+
+extern "C" gs_texture_t *gs_texture_create(uint32_t, uint32_t, enum gs_color_format, uint32_t, const uint8_t **,
+					   uint32_t)
+{
+	return new gs_texture{};
+}
+
+extern "C" void gs_texture_destroy(gs_texture_t *tex)
+{
+	delete tex;
+}
+
+// The buffer owns data, as in libobs
+extern "C" gs_vertbuffer_t *gs_vertexbuffer_create(struct gs_vb_data *data, uint32_t)
+{
+	return new gs_vertex_buffer{data};
+}
+
+extern "C" void gs_vertexbuffer_destroy(gs_vertbuffer_t *vertbuffer)
+{
+	if (!vertbuffer)
+		return;
+	bfree(vertbuffer->data->points);
+	bfree(vertbuffer->data->colors);
+	bfree(vertbuffer->data);
+	delete vertbuffer;
+}
+
+extern "C" struct gs_vb_data *gs_vertexbuffer_get_data(const gs_vertbuffer_t *vertbuffer)
+{
+	return vertbuffer->data;
+}
+
+extern "C" void gs_vertexbuffer_flush(gs_vertbuffer_t *) {}
+extern "C" void gs_load_vertexbuffer(gs_vertbuffer_t *) {}
+extern "C" void gs_load_indexbuffer(void *) {}
+
+extern "C" void gs_draw(enum gs_draw_mode, uint32_t, uint32_t)
+{
+	g_draws.fetch_add(1, std::memory_order_relaxed);
+}
+
+extern "C" void gs_clear(uint32_t, const struct vec4 *, float, uint8_t) {}
+extern "C" void gs_ortho(float, float, float, float, float, float) {}
+extern "C" void gs_blend_state_push(void) {}
+extern "C" void gs_blend_state_pop(void) {}
+extern "C" void gs_blend_function(enum gs_blend_type, enum gs_blend_type) {}
+extern "C" void gs_blend_function_separate(enum gs_blend_type, enum gs_blend_type, enum gs_blend_type,
+					   enum gs_blend_type)
+{
+}
+
+// No decoder: images never load, which the plugin treats like a missing file
+extern "C" void gs_image_file_init(gs_image_file_t *image, const char *)
+{
+	memset(image, 0, sizeof(*image));
+}
+
+extern "C" void gs_image_file_free(gs_image_file_t *image)
+{
+	memset(image, 0, sizeof(*image));
+}
+
+extern "C" void gs_image_file_init_texture(gs_image_file_t *) {}
+
+extern "C" bool gs_image_file_tick(gs_image_file_t *, uint64_t)
+{
+	return false;
+}
+
+extern "C" gs_effect_t *obs_get_base_effect(enum obs_base_effect effect)
+{
+	return &g_base_effects[effect];
+}
+
+extern "C" void obs_enter_graphics(void) {}
+extern "C" void obs_leave_graphics(void) {}
+
+extern "C" void obs_stub_get_gs_counters(struct obs_stub_gs_counters *out)
+{
+	out->draws = g_draws.load(std::memory_order_relaxed);
+	out->texrenders = g_texrenders.load(std::memory_order_relaxed);
+	out->child_renders = g_child_renders.load(std::memory_order_relaxed);
+}
+
+// ------------------------ Sources ------------------------
+static std::mutex g_types_mutex;
+static std::unordered_map<std::string, obs_source_info> g_types;
+
+// Registered types run the plugin's callbacks; the built-in text/image types are sized boxes
+struct obs_source {
+	std::atomic<long> refs{1};
+	const obs_source_info *info = nullptr;
+	std::string name;
+	obs_data_t *settings = nullptr;
+	void *data = nullptr;
+	bool enabled = true;
+	uint32_t cx = 0;
+	uint32_t cy = 0;
+	signal_handler handler;
+};
+
+extern "C" void obs_register_source_s(const struct obs_source_info *info, size_t size)
+{
+	obs_source_info copy = {};
+	memcpy(&copy, info, size < sizeof(copy) ? size : sizeof(copy));
+	std::lock_guard<std::mutex> lock(g_types_mutex);
+	g_types[info->id] = copy;
+}
+
+static const obs_source_info *find_type(const char *id)
+{
+	std::lock_guard<std::mutex> lock(g_types_mutex);
+	auto it = g_types.find(id);
+	return it != g_types.end() ? &it->second : nullptr;
+}
+
+static void builtin_update(obs_source_t *source)
+{
+	const char *text = obs_data_get_string(source->settings, "text");
+	if (*text) {
+		source->cx = 12 * (uint32_t)strlen(text);
+		source->cy = 32;
+	} else {
+		source->cx = source->cy = 64;
+	}
+}
+
+extern "C" obs_source_t *obs_source_create_private(const char *id, const char *name, obs_data_t *settings)
+{
+	const obs_source_info *info = find_type(id);
+	const bool builtin = !strncmp(id, "text_", 5) || !strcmp(id, "image_source");
+	if (!info && !builtin)
+		return nullptr;
+
+	auto *source = new obs_source();
+	source->info = info;
+	source->name = name ? name : "";
+	source->settings = settings ? data_addref(settings) : obs_data_create();
+	if (info) {
+		if (info->get_defaults)
+			info->get_defaults(source->settings);
+		source->data = info->create(source->settings, source);
+	} else {
+		builtin_update(source);
+	}
+	return source;
+}
+
+extern "C" obs_source_t *obs_source_get_ref(obs_source_t *source)
+{
+	if (source)
+		source->refs.fetch_add(1, std::memory_order_relaxed);
+	return source;
+}
+
+extern "C" void obs_source_release(obs_source_t *source)
+{
+	if (!source || source->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		return;
+	if (source->info && source->info->destroy)
+		source->info->destroy(source->data);
+	obs_data_release(source->settings);
+	delete source;
+}
+
+extern "C" void obs_source_update(obs_source_t *source, obs_data_t *settings)
+{
+	data_apply(source->settings, settings);
+	if (source->info && source->info->update)
+		source->info->update(source->data, source->settings);
+	else if (!source->info)
+		builtin_update(source);
+}
+
+extern "C" void obs_source_set_enabled(obs_source_t *source, bool enabled)
+{
+	source->enabled = enabled;
+}
+
+extern "C" uint32_t obs_source_get_width(obs_source_t *source)
+{
+	if (source->info)
+		return source->info->get_width ? source->info->get_width(source->data) : 0;
+	return source->cx;
+}
+
+extern "C" uint32_t obs_source_get_height(obs_source_t *source)
+{
+	if (source->info)
+		return source->info->get_height ? source->info->get_height(source->data) : 0;
+	return source->cy;
+}
+
+extern "C" void obs_source_video_tick(obs_source_t *source, float seconds)
+{
+	if (source->info && source->info->video_tick)
+		source->info->video_tick(source->data, seconds);
+}
+
+extern "C" void obs_source_video_render(obs_source_t *source)
+{
+	if (!source->enabled)
+		return;
+	if (source->info) {
+		if (source->info->video_render)
+			source->info->video_render(source->data, nullptr);
+		return;
+	}
+	g_child_renders.fetch_add(1, std::memory_order_relaxed);
+	gs_draw_sprite(nullptr, 0, source->cx, source->cy);
+}
+
+// No mixer: cues are dropped
+extern "C" void obs_source_output_audio(obs_source_t *, const struct obs_source_audio *) {}
+
+extern "C" const char *obs_source_get_name(const obs_source_t *source)
+{
+	return source->name.c_str();
+}
+
+extern "C" uint32_t obs_source_get_output_flags(const obs_source_t *source)
+{
+	return source->info ? source->info->output_flags : 0;
+}
+
+// Every benchmarked source counts as being in the program scene
+extern "C" bool obs_source_active(const obs_source_t *)
+{
+	return true;
+}
+
+extern "C" signal_handler_t *obs_source_get_signal_handler(const obs_source_t *source)
+{
+	return const_cast<signal_handler_t *>(&source->handler);
+}
+
+// ------------------------ Outputs and pipeline ------------------------
+struct obs_output {
+	std::string name = "simple_stream";
+	std::atomic<bool> active{false};
+	std::atomic<uint32_t> total{0};
+	std::atomic<uint32_t> dropped{0};
+	std::atomic<uint64_t> bytes{0};
+	signal_handler handler;
+};
+
+struct obs_weak_output {
+	obs_output_t *output;
+};
+
+struct video_output {
+	int unused;
+};
+
+static obs_output g_stream_output;
+static video_output g_video;
+
+extern "C" bool obs_output_active(const obs_output_t *output)
+{
+	return output->active.load(std::memory_order_relaxed);
+}
+
+// The one output lives as long as the process
+extern "C" void obs_output_release(obs_output_t *) {}
+
+extern "C" obs_weak_output_t *obs_output_get_weak_output(obs_output_t *output)
+{
+	return new obs_weak_output{output};
+}
+
+extern "C" obs_output_t *obs_weak_output_get_output(obs_weak_output_t *weak)
+{
+	return weak->output;
+}
+
+extern "C" void obs_weak_output_release(obs_weak_output_t *weak)
+{
+	delete weak;
+}
+
+extern "C" bool obs_weak_output_references_output(obs_weak_output_t *weak, obs_output_t *output)
+{
+	return weak && weak->output == output;
+}
+
+extern "C" int obs_output_get_frames_dropped(const obs_output_t *output)
+{
+	return (int)output->dropped.load(std::memory_order_relaxed);
+}
+
+extern "C" int obs_output_get_total_frames(const obs_output_t *output)
+{
+	return (int)output->total.load(std::memory_order_relaxed);
+}
+
+extern "C" uint64_t obs_output_get_total_bytes(const obs_output_t *output)
+{
+	return output->bytes.load(std::memory_order_relaxed);
+}
+
+extern "C" float obs_output_get_congestion(obs_output_t *)
+{
+	return 0.0f;
+}
+
+extern "C" const char *obs_output_get_name(const obs_output_t *output)
+{
+	return output->name.c_str();
+}
+
+extern "C" signal_handler_t *obs_output_get_signal_handler(const obs_output_t *output)
+{
+	return const_cast<signal_handler_t *>(&output->handler);
+}
+
+extern "C" void obs_enum_outputs(bool (*enum_proc)(void *, obs_output_t *), void *param)
+{
+	enum_proc(param, &g_stream_output);
+}
+
+// Pipeline counters follow the streaming output, without encoder skips or render lag
+extern "C" uint32_t obs_get_lagged_frames(void)
+{
+	return 0;
+}
+
+extern "C" uint32_t obs_get_total_frames(void)
+{
+	return g_stream_output.total.load(std::memory_order_relaxed);
+}
+
+extern "C" video_t *obs_get_video(void)
+{
+	return &g_video;
+}
+
+extern "C" uint32_t video_output_get_skipped_frames(const video_t *)
+{
+	return 0;
+}
+
+extern "C" uint32_t video_output_get_total_frames(const video_t *)
+{
+	return g_stream_output.total.load(std::memory_order_relaxed);
+}
+
+extern "C" obs_output_t *obs_stub_streaming_output(void)
+{
+	return &g_stream_output;
+}
+
+extern "C" void obs_stub_output_set_active(obs_output_t *output, bool active)
+{
+	output->active.store(active, std::memory_order_relaxed);
+	calldata_t cd;
+	signal_handler_signal(&output->handler, active ? "start" : "stop", &cd);
+}
+
+extern "C" void obs_stub_output_add_frames(obs_output_t *output, uint32_t total, uint32_t dropped)
+{
+	output->total.fetch_add(total, std::memory_order_relaxed);
+	output->dropped.fetch_add(dropped, std::memory_order_relaxed);
+	output->bytes.fetch_add((uint64_t)total * 20000, std::memory_order_relaxed);
+}
+
+// ------------------------ Frontend ------------------------
+static std::mutex g_frontend_mutex;
+static std::vector<std::pair<obs_frontend_event_cb, void *>> g_frontend_callbacks;
+
+extern "C" void obs_frontend_add_event_callback(obs_frontend_event_cb callback, void *private_data)
+{
+	std::lock_guard<std::mutex> lock(g_frontend_mutex);
+	g_frontend_callbacks.emplace_back(callback, private_data);
+}
+
+extern "C" void obs_frontend_remove_event_callback(obs_frontend_event_cb callback, void *private_data)
+{
+	std::lock_guard<std::mutex> lock(g_frontend_mutex);
+	for (auto it = g_frontend_callbacks.begin(); it != g_frontend_callbacks.end(); ++it) {
+		if (it->first == callback && it->second == private_data) {
+			g_frontend_callbacks.erase(it);
+			return;
+		}
+	}
+}
+
+extern "C" obs_output_t *obs_frontend_get_streaming_output(void)
+{
+	return &g_stream_output;
+}
+
+extern "C" void obs_stub_frontend_event(enum obs_frontend_event event)
+{
+	std::vector<std::pair<obs_frontend_event_cb, void *>> callbacks;
+	{
+		std::lock_guard<std::mutex> lock(g_frontend_mutex);
+		callbacks = g_frontend_callbacks;
+	}
+	for (const auto &[callback, data] : callbacks)
+		callback(event, data);
+}
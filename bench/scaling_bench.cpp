@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Scaling benchmark for the whole source: registers the plugin against the libobs stand-in
+// in obs-stub/, creates 1, 10, 100 and 1000 Online Status sources and reports what ticking
+// and rendering all of them costs per frame, and what one settings update costs, while idle,
+// streaming cleanly and dropping frames. Frames are paced at 60 fps so the shared sampler
+// publishes at its real rate; only the plugin callbacks are timed. With --linked every source
+// joins one linked group, which should keep the tick cost flat as sources are added.
+#include <obs-module.h>
+#include <obs-frontend-api.h>
+#include <obs-stub.h>
+#include <util/platform.h>
+#include "online_status_anim.hpp"
+#include "online_status_audio.hpp"
+#include "online_status_incidents.hpp"
+#include "online_status_loader.hpp"
+#include "online_status_metrics.hpp"
+#include "online_status_recorder.hpp"
+#include "online_status_sampler.hpp"
+#include "online_status_shm.hpp"
+#include "online_status_trace.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+void register_online_status_source(void);
+
+static constexpr uint32_t kWarmupFrames = 30; // let the detector settle into each phase
+static const uint32_t kSourceCounts[] = {1, 10, 100, 1000};
+
+// What the streaming output reports each frame
+struct Phase {
+	const char *name;
+	bool streaming;
+	uint32_t dropped_per_frame; // of 2 frames sent per rendered frame
+};
+
+static const Phase kPhases[] = {
+	{"idle", false, 0},
+	{"streaming", true, 0},
+	{"dropping", true, 1},
+};
+
+struct FrameCost {
+	uint64_t tick_ns = 0;
+	uint64_t render_ns = 0;
+	uint64_t draws = 0;
+	uint64_t child_renders = 0;
+};
+
+static void set_streaming(bool streaming)
+{
+	obs_output_t *output = obs_stub_streaming_output();
+	if (streaming) {
+		obs_stub_frontend_event(OBS_FRONTEND_EVENT_STREAMING_STARTING);
+		obs_stub_output_set_active(output, true);
+		obs_stub_frontend_event(OBS_FRONTEND_EVENT_STREAMING_STARTED);
+	} else {
+		obs_stub_frontend_event(OBS_FRONTEND_EVENT_STREAMING_STOPPING);
+		obs_stub_output_set_active(output, false);
+		obs_stub_frontend_event(OBS_FRONTEND_EVENT_STREAMING_STOPPED);
+	}
+}
+
+// Tick every source, then render every source, like one pass of the OBS graphics thread
+static FrameCost run_frames(const std::vector<obs_source_t *> &sources, const Phase &phase, uint32_t frames)
+{
+	using clock = std::chrono::steady_clock;
+	const auto frame_period = std::chrono::nanoseconds(1000000000 / 60);
+	const float seconds = 1.0f / 60.0f;
+	obs_output_t *output = obs_stub_streaming_output();
+
+	FrameCost cost;
+	auto deadline = clock::now();
+	for (uint32_t i = 0; i < kWarmupFrames + frames; i++) {
+		if (phase.streaming)
+			obs_stub_output_add_frames(output, 2, phase.dropped_per_frame);
+
+		struct obs_stub_gs_counters before;
+		obs_stub_get_gs_counters(&before);
+		const uint64_t t0 = os_gettime_ns();
+		for (obs_source_t *source : sources)
+			obs_source_video_tick(source, seconds);
+		const uint64_t t1 = os_gettime_ns();
+		for (obs_source_t *source : sources)
+			obs_source_video_render(source);
+		const uint64_t t2 = os_gettime_ns();
+		struct obs_stub_gs_counters after;
+		obs_stub_get_gs_counters(&after);
+
+		if (i >= kWarmupFrames) {
+			cost.tick_ns += t1 - t0;
+			cost.render_ns += t2 - t1;
+			cost.draws += after.draws - before.draws;
+			cost.child_renders += after.child_renders - before.child_renders;
+		}
+		deadline += frame_period;
+		std::this_thread::sleep_until(deadline);
+	}
+	return cost;
+}
+
+// Alternate the dropping text on every source; returns ns per update
+static double run_updates(const std::vector<obs_source_t *> &sources, uint32_t rounds)
+{
+	obs_data_t *a = obs_data_create();
+	obs_data_t *b = obs_data_create();
+	obs_data_set_string(a, "status_text", "Dropping frames");
+	obs_data_set_string(b, "status_text", "Connection unstable");
+
+	const uint64_t start = os_gettime_ns();
+	for (uint32_t r = 0; r < rounds; r++)
+		for (obs_source_t *source : sources)
+			obs_source_update(source, (r & 1) ? b : a);
+	const uint64_t elapsed = os_gettime_ns() - start;
+
+	obs_data_release(a);
+	obs_data_release(b);
+	return (double)elapsed / ((double)rounds * (double)sources.size());
+}
+
+static void run_count(uint32_t count, uint32_t frames, bool linked)
+{
+	std::vector<obs_source_t *> sources;
+	sources.reserve(count);
+	obs_data_t *settings = obs_data_create();
+	obs_data_set_string(settings, "status_text", "Dropping frames");
+	obs_data_set_bool(settings, "drop_sound", true);
+	if (linked)
+		obs_data_set_string(settings, "link_group", "bench");
+
+	const uint64_t create_start = os_gettime_ns();
+	for (uint32_t i = 0; i < count; i++) {
+		const std::string name = "Online Status " + std::to_string(i + 1);
+		sources.push_back(obs_source_create_private("online-status", name.c_str(), settings));
+	}
+	const double create_us = (double)(os_gettime_ns() - create_start) / 1000.0 / count;
+	obs_data_release(settings);
+
+	const double update_ns = run_updates(sources, count >= 100 ? 4 : 64);
+
+	for (const Phase &phase : kPhases) {
+		set_streaming(phase.streaming);
+		const FrameCost cost = run_frames(sources, phase, frames);
+		const double tick_us = (double)cost.tick_ns / 1000.0 / frames;
+		const double render_us = (double)cost.render_ns / 1000.0 / frames;
+		const double per_source_ns = (double)(cost.tick_ns + cost.render_ns) / frames / count;
+		printf("%7u  %-10s %12.2f %12.2f %12.1f %10.1f %10.1f %10.2f %10.2f\n", count, phase.name, tick_us,
+		       render_us, per_source_ns, (double)cost.draws / frames, (double)cost.child_renders / frames,
+		       update_ns / 1000.0, create_us);
+	}
+	set_streaming(false);
+
+	for (obs_source_t *source : sources)
+		obs_source_release(source);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t frames = 120;
+	bool linked = false;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--linked"))
+			linked = true;
+		else
+			frames = (uint32_t)strtoul(argv[i], nullptr, 10);
+	}
+	if (!frames) {
+		fprintf(stderr, "usage: %s [frames-per-phase] [--linked]\n", argv[0]);
+		return 1;
+	}
+
+	online_status_incidents_open();
+	online_status_audio_init();
+	register_online_status_source();
+	online_status_sampler_start();
+
+	printf("%u frames per phase at 60 fps (after %u warm-up frames)%s\n\n", frames, kWarmupFrames,
+	       linked ? ", all sources in one linked group" : "");
+	printf("%7s  %-10s %12s %12s %12s %10s %10s %10s %10s\n", "sources", "phase", "tick us/fr", "render us/fr",
+	       "ns/source", "draws/fr", "children", "update us", "create us");
+	for (uint32_t count : kSourceCounts)
+		run_count(count, frames, linked);
+
+	online_status_metrics_stop();
+	online_status_shm_stop();
+	online_status_trace_stop();
+	online_status_recorder_stop();
+	online_status_sampler_stop();
+	online_status_loader_stop();
+	online_status_anim_unload();
+	online_status_incidents_close();
+	return 0;
+}
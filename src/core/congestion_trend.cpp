@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "core/congestion_trend.hpp"
+#include <cmath>
+
+static constexpr double kBaselineTauSec = 30.0;  // bitrate baseline follows slowly
+static constexpr double kDegradedTauSec = 300.0; // and much slower while degrading
+static constexpr float kBaselineWarmupSec = 5.0f; // no bitrate verdict before this
+static constexpr double kMinBaselineKbps = 100.0; // ignore idle/near-empty outputs
+
+// Blend factor of a time-constant EWMA for a step of dt seconds
+static inline double ewma_alpha(double dt, double tau)
+{
+	if (tau <= 0.0)
+		return 1.0;
+	return 1.0 - exp(-dt / tau);
+}
+
+void congestion_trend_reset(CongestionTrend *t)
+{
+	*t = CongestionTrend{};
+}
+
+void congestion_trend_push(CongestionTrend *t, const CongestionTrendConfig *cfg, uint64_t timestamp_ns,
+			   double congestion, uint64_t total_bytes)
+{
+	const double pct = congestion * 100.0;
+
+	// First sample, or counters restarted: start over from here
+	if (!t->primed || timestamp_ns <= t->last_timestamp_ns || total_bytes < t->last_bytes) {
+		congestion_trend_reset(t);
+		t->primed = true;
+		t->last_timestamp_ns = timestamp_ns;
+		t->last_bytes = total_bytes;
+		t->congestion = pct;
+		return;
+	}
+
+	const double dt = (double)(timestamp_ns - t->last_timestamp_ns) / 1e9;
+	const double a = ewma_alpha(dt, cfg->smoothing_sec);
+
+	const double prev_congestion = t->congestion;
+	t->congestion += a * (pct - t->congestion);
+	t->slope += a * ((t->congestion - prev_congestion) / dt - t->slope);
+
+	const double kbps = (double)(total_bytes - t->last_bytes) * 8.0 / 1000.0 / dt;
+	t->kbps = t->baseline_sec > 0.0f ? t->kbps + a * (kbps - t->kbps) : kbps;
+
+	// Degrading periods barely move the baseline, so a slow sag cannot hide itself, but a
+	// lasting drop (e.g. a lower bitrate set mid-stream) becomes the new normal after minutes
+	if (!congestion_trend_degrading(t, cfg)) {
+		const double b = t->baseline_sec > 0.0f ? ewma_alpha(dt, kBaselineTauSec) : 1.0;
+		t->baseline_kbps += b * (t->kbps - t->baseline_kbps);
+		t->baseline_sec += (float)dt;
+	} else {
+		t->baseline_kbps += ewma_alpha(dt, kDegradedTauSec) * (t->kbps - t->baseline_kbps);
+	}
+
+	t->last_timestamp_ns = timestamp_ns;
+	t->last_bytes = total_bytes;
+}
+
+bool congestion_trend_degrading(const CongestionTrend *t, const CongestionTrendConfig *cfg)
+{
+	if (!t->primed)
+		return false;
+	if (cfg->congestion_pct > 0.0 && t->congestion >= cfg->congestion_pct)
+		return true;
+	if (cfg->slope_pct_per_sec > 0.0 && t->slope >= cfg->slope_pct_per_sec)
+		return true;
+	if (cfg->bitrate_drop_pct > 0.0 && t->baseline_sec >= kBaselineWarmupSec &&
+	    t->baseline_kbps >= kMinBaselineKbps) {
+		const double floor_kbps = t->baseline_kbps * (1.0 - cfg->bitrate_drop_pct / 100.0);
+		return t->kbps < floor_kbps;
+	}
+	return false;
+}
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Early-warning trend model over output congestion and sent bytes. Congestion and bitrate
+// are smoothed with time-based EWMAs so the result does not depend on the sample rate.
+#include <stdint.h>
+
+struct CongestionTrendConfig {
+	double congestion_pct = 50.0;    // warn when smoothed congestion (0-100) reaches this
+	double slope_pct_per_sec = 20.0; // or when congestion rises faster than this
+	double bitrate_drop_pct = 30.0;  // or when bitrate falls this far below its baseline (0 = off)
+	float smoothing_sec = 1.0f;      // EWMA time constant for congestion, slope and bitrate
+};
+
+struct CongestionTrend {
+	bool primed = false;
+	uint64_t last_timestamp_ns = 0;
+	uint64_t last_bytes = 0;
+
+	double congestion = 0.0;    // smoothed congestion, 0-100
+	double slope = 0.0;         // smoothed congestion change, pct per second
+	double kbps = 0.0;          // smoothed bitrate
+	double baseline_kbps = 0.0; // slow bitrate average, slower still while degrading
+	float baseline_sec = 0.0f;  // healthy time folded into the baseline
+};
+
+void congestion_trend_reset(CongestionTrend *t);
+
+// Feed one sample: congestion as reported by libobs (0-1) and cumulative bytes sent
+void congestion_trend_push(CongestionTrend *t, const CongestionTrendConfig *cfg, uint64_t timestamp_ns,
+			   double congestion, uint64_t total_bytes);
+
+// True while the trend points at trouble ahead
+bool congestion_trend_degrading(const CongestionTrend *t, const CongestionTrendConfig *cfg);
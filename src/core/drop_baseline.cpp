@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "core/drop_baseline.hpp"
+#include <math.h>
+
+static constexpr double kLowestPct = 0.001; // upper edge of bucket 0
+static constexpr double kBucketsPerDecade = 12.0;
+static constexpr float kMaxGapSec = 1.0f;   // longer gaps (sampler stalls) count as this
+static constexpr float kRefreshSec = 1.0f;
+static constexpr double kRescaleAt = 1e150; // fold scale back into the buckets before it overflows
+
+static inline int bucket_of(double pct)
+{
+	if (pct < kLowestPct)
+		return 0;
+	const int i = 1 + (int)(kBucketsPerDecade * log10(pct / kLowestPct));
+	return i < DropBaseline::kBuckets ? i : DropBaseline::kBuckets - 1;
+}
+
+// Upper edge of a bucket, so the percentile errs on the quiet side
+static inline double bucket_top(int i)
+{
+	return i == 0 ? 0.0 : kLowestPct * pow(10.0, (double)i / kBucketsPerDecade);
+}
+
+static void refresh_quantile(DropBaseline *b, const DropBaselineConfig *cfg)
+{
+	const double target = b->total * cfg->quantile / 100.0;
+	double sum = 0.0;
+	int i = 0;
+	for (; i < DropBaseline::kBuckets - 1; i++) {
+		sum += b->weight[i];
+		if (sum >= target)
+			break;
+	}
+	b->quantile_pct = bucket_top(i);
+	b->since_refresh = 0.0f;
+}
+
+void drop_baseline_reset(DropBaseline *b)
+{
+	*b = DropBaseline{};
+}
+
+void drop_baseline_push(DropBaseline *b, const DropBaselineConfig *cfg, uint64_t timestamp_ns, double pct)
+{
+	const uint64_t prev_ns = b->last_ns;
+	b->last_ns = timestamp_ns;
+	if (!prev_ns || timestamp_ns <= prev_ns)
+		return;
+	float dt = (float)((double)(timestamp_ns - prev_ns) / 1e9);
+	if (dt > kMaxGapSec)
+		dt = kMaxGapSec;
+
+	// Newer samples weigh more; relative to them, older ones fade with the half-life
+	if (cfg->half_life_sec > 0.0f)
+		b->scale *= exp2((double)dt / cfg->half_life_sec);
+	if (b->scale > kRescaleAt) {
+		for (double &w : b->weight)
+			w /= b->scale;
+		b->total /= b->scale;
+		b->scale = 1.0;
+	}
+	const double w = b->scale * dt;
+	b->weight[bucket_of(pct)] += w;
+	b->total += w;
+
+	b->learned_sec += dt;
+	b->since_refresh += dt;
+	if (b->since_refresh >= kRefreshSec && drop_baseline_ready(b, cfg))
+		refresh_quantile(b, cfg);
+}
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Long-running profile of one signal's windowed drop %, so the alert can mean "worse than
+// usual for this stream" instead of a fixed number. A fixed log-spaced histogram (12 buckets
+// per decade from 0.001 %) weighted by time, with exponential forgetting: instead of
+// decaying every bucket, new samples get a weight that grows over time, so a push is O(1)
+// and memory never grows.
+#include <stdint.h>
+
+struct DropBaselineConfig {
+	double quantile = 99.0;        // alert above this percentile of the baseline
+	float learn_sec = 120.0f;      // streaming time before the baseline is trusted
+	float half_life_sec = 1800.0f; // samples count half after this long
+	double min_pct = 0.05;         // never alert below this, however clean the baseline
+};
+
+struct DropBaseline {
+	static constexpr int kBuckets = 64; // bucket 0 holds everything below 0.001 %
+
+	double weight[kBuckets] = {};
+	double total = 0.0;
+	double scale = 1.0;         // weight of one second of samples pushed now
+	uint64_t last_ns = 0;       // timestamp of the previous sample, 0 = none
+	float learned_sec = 0.0f;   // sample time seen since the last reset
+	float since_refresh = 0.0f; // sample time since quantile_pct was refreshed
+	double quantile_pct = 0.0;  // cached percentile, refreshed about once per second
+};
+
+void drop_baseline_reset(DropBaseline *b);
+
+// Fold one windowed drop % in, weighted by the time since the previous sample
+void drop_baseline_push(DropBaseline *b, const DropBaselineConfig *cfg, uint64_t timestamp_ns, double pct);
+
+// Enough stream time seen to alert relative to the baseline
+static inline bool drop_baseline_ready(const DropBaseline *b, const DropBaselineConfig *cfg)
+{
+	return b->learned_sec >= cfg->learn_sec;
+}
+
+// Drop % the alert starts at: the percentile, but at least min_pct
+static inline double drop_baseline_threshold(const DropBaseline *b, const DropBaselineConfig *cfg)
+{
+	return b->quantile_pct > cfg->min_pct ? b->quantile_pct : cfg->min_pct;
+}
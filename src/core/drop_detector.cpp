@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "core/drop_detector.hpp"
+
+// ------------------------ Helpers ------------------------
+static inline void reset_stable(DropDetector *d)
+{
+	d->stable_visible = false;
+	d->stable_timer = 0.0f;
+}
+
+// Also frees the window; it is allocated again by the next sample the signal measures
+static void reset_signal(DropSignal *sig)
+{
+	sig->prev_total = sig->prev_dropped = 0;
+	sig->pct = 0.0;
+	drop_window_release(&sig->window);
+}
+
+// Feed new counters into the window and refresh the windowed drop %
+static void evaluate_signal(DropSignal *sig, const FrameCounters *c, uint64_t timestamp_ns, uint64_t window_ns)
+{
+	// Reset counters if OBS restarted stats
+	if (c->total < sig->prev_total || c->dropped < sig->prev_dropped)
+		drop_window_clear(&sig->window);
+	sig->prev_total = c->total;
+	sig->prev_dropped = c->dropped;
+	sig->pct = drop_window_push(&sig->window, timestamp_ns, c->total, c->dropped, window_ns);
+}
+
+// Hysteresis: the enter threshold shows the overlay, the exit threshold keeps it up.
+// Learned thresholds keep the configured exit/enter ratio.
+// Returns the most upstream signal over its threshold, or DROP_CAUSE_NONE.
+static int hot_cause(const DropDetector *d, const DropDetectorConfig *cfg)
+{
+	const double exit_ratio =
+		cfg->drop_threshold_pct > 0.0 ? cfg->drop_exit_threshold_pct / cfg->drop_threshold_pct : 1.0;
+	for (int c = DROP_CAUSE_COUNT - 1; c >= 0; c--) {
+		const double pct = d->signals[c].pct;
+		if (!cfg->signal_enabled[c] || pct <= 0.0)
+			continue;
+		double threshold = drop_detector_threshold_pct(d, cfg, c);
+		if (d->auto_visible)
+			threshold *= exit_ratio;
+		if (pct >= threshold)
+			return c;
+	}
+	return DROP_CAUSE_NONE;
+}
+
+// Forget everything measured so far (stream stopped or connection lost)
+static void reset_measurements(DropDetector *d)
+{
+	for (DropSignal &sig : d->signals)
+		reset_signal(&sig);
+	d->since_last_drop = 0.0f;
+	d->auto_visible = false;
+	d->cause = DROP_CAUSE_NONE;
+	d->degrading_visible = false;
+	congestion_trend_reset(&d->trend);
+	reset_stable(d);
+}
+
+// Early warning: raise "degrading" on a bad trend, but never on top of the dropping overlay
+static void update_degrading(DropDetector *d, const DropDetectorConfig *cfg, float seconds)
+{
+	if (!cfg->degrade_enabled || d->auto_visible) {
+		d->degrading_visible = false;
+		d->since_degraded = 0.0f;
+		return;
+	}
+	if (congestion_trend_degrading(&d->trend, &cfg->trend)) {
+		d->degrading_visible = true;
+		d->since_degraded = 0.0f;
+		// Trouble ahead supersedes "stable again"
+		reset_stable(d);
+	} else if (d->degrading_visible) {
+		d->since_degraded += seconds;
+		if (d->since_degraded >= cfg->hide_after_sec)
+			d->degrading_visible = false;
+	}
+}
+
+// ------------------------ State machine ------------------------
+void drop_detector_tick(DropDetector *d, const DropDetectorConfig *cfg, const DropSample *sample, float seconds)
+{
+	const bool prev_auto_visible = d->auto_visible;
+
+	// Test override: force dropping overlay regardless of streaming state
+	if (cfg->force_drop) {
+		d->auto_visible = true;
+		d->degrading_visible = false;
+		d->reconnecting = false;
+		d->reconnect_test_sec = 0.0f;
+		if (d->cause == DROP_CAUSE_NONE)
+			d->cause = DROP_CAUSE_NETWORK;
+		d->since_last_drop = 0.0f;
+		reset_stable(d);
+	} else if (sample->active && (sample->reconnecting || d->reconnect_test_sec > 0.0f)) {
+		// Connection lost: counters are meaningless until the output is back
+		if (!d->reconnecting) {
+			reset_measurements(d);
+			d->reconnecting = true;
+			d->reconnect_sec = 0.0f;
+		} else {
+			d->reconnect_sec += seconds;
+		}
+		d->reconnect_test_sec = sample->reconnecting ? 0.0f : d->reconnect_test_sec - seconds;
+	} else if (!sample->active) {
+		// Not streaming: reset and hide; the next stream may take another route
+		reset_measurements(d);
+		for (DropSignal &sig : d->signals) {
+			if (sig.baseline.last_ns)
+				drop_baseline_reset(&sig.baseline);
+		}
+		d->reconnecting = false;
+		d->reconnect_test_sec = 0.0f;
+	} else {
+		// Back from a reconnect: start measuring afresh and say so
+		if (d->reconnecting) {
+			d->reconnecting = false;
+			reset_measurements(d);
+			if (cfg->stable_enabled && cfg->reconnect_enabled) {
+				d->stable_visible = true;
+				d->stable_timer = cfg->stable_duration_sec;
+			}
+		}
+
+		// Only evaluate drops when a new sample arrived; all signals in one pass
+		if (sample->fresh) {
+			const uint64_t window_ns = (uint64_t)cfg->drop_window_ms * 1000000ULL;
+			for (int c = 0; c < DROP_CAUSE_COUNT; c++) {
+				DropSignal &sig = d->signals[c];
+				if (!cfg->signal_enabled[c]) {
+					reset_signal(&sig);
+					continue;
+				}
+				evaluate_signal(&sig, &sample->counters[c], sample->timestamp_ns, window_ns);
+				// Once learned, alerts stay out of the baseline so it does not drift up
+				// to meet a lasting problem
+				const bool learned = drop_baseline_ready(&sig.baseline, &cfg->baseline);
+				if (cfg->adaptive && !(learned && d->auto_visible))
+					drop_baseline_push(&sig.baseline, &cfg->baseline, sample->timestamp_ns, sig.pct);
+			}
+			if (cfg->degrade_enabled)
+				congestion_trend_push(&d->trend, &cfg->trend, sample->timestamp_ns, sample->congestion,
+						      sample->total_bytes);
+		}
+
+		const int cause = hot_cause(d, cfg);
+		if (cause != DROP_CAUSE_NONE) {
+			d->auto_visible = true;
+			d->cause = cause;
+			d->since_last_drop = 0.0f;
+			// Any new drop cancels stable overlay
+			reset_stable(d);
+		} else {
+			d->since_last_drop += seconds;
+			if (d->since_last_drop >= cfg->hide_after_sec) {
+				d->auto_visible = false;
+				d->cause = DROP_CAUSE_NONE;
+			}
+		}
+
+		// Handle transition to stable overlay
+		if (cfg->stable_enabled) {
+			if (prev_auto_visible && !d->auto_visible) {
+				d->stable_visible = true;
+				d->stable_timer = cfg->stable_duration_sec;
+			}
+			if (d->stable_visible) {
+				d->stable_timer -= seconds;
+				if (d->stable_timer <= 0.0f)
+					reset_stable(d);
+			}
+		} else {
+			reset_stable(d);
+		}
+
+		update_degrading(d, cfg, seconds);
+	}
+}
+
+// ------------------------ Manual overrides ------------------------
+void drop_detector_trigger(DropDetector *d)
+{
+	d->reconnecting = false;
+	d->auto_visible = true;
+	d->degrading_visible = false;
+	d->cause = DROP_CAUSE_NETWORK;
+	d->since_last_drop = 0.0f;
+	reset_stable(d);
+}
+
+void drop_detector_show_stable(DropDetector *d, const DropDetectorConfig *cfg)
+{
+	d->reconnecting = false;
+	d->auto_visible = false;
+	d->cause = DROP_CAUSE_NONE;
+	d->degrading_visible = false;
+	d->stable_visible = true;
+	d->stable_timer = cfg->stable_duration_sec;
+}
+
+void drop_detector_show_degrading(DropDetector *d)
+{
+	d->reconnecting = false;
+	d->auto_visible = false;
+	d->cause = DROP_CAUSE_NONE;
+	d->degrading_visible = true;
+	d->since_degraded = 0.0f;
+	reset_stable(d);
+}
+
+void drop_detector_show_reconnecting(DropDetector *d, float hold_sec)
+{
+	d->auto_visible = false;
+	d->cause = DROP_CAUSE_NONE;
+	d->degrading_visible = false;
+	d->reconnecting = true;
+	d->reconnect_sec = 0.0f;
+	d->reconnect_test_sec = hold_sec;
+	reset_stable(d);
+}
+
+void drop_detector_hide_all(DropDetector *d)
+{
+	d->auto_visible = false;
+	d->reconnecting = false;
+	d->reconnect_test_sec = 0.0f;
+	d->degrading_visible = false;
+	d->cause = DROP_CAUSE_NONE;
+	reset_stable(d);
+}
+
+void drop_detector_apply_commands(DropDetector *d, const DropDetectorConfig *cfg, uint32_t commands)
+{
+	if (commands & DROP_COMMAND_TRIGGER)
+		drop_detector_trigger(d);
+	if (commands & DROP_COMMAND_SHOW_STABLE)
+		drop_detector_show_stable(d, cfg);
+	if (commands & DROP_COMMAND_SHOW_DEGRADING)
+		drop_detector_show_degrading(d);
+	if (commands & DROP_COMMAND_SHOW_RECONNECTING)
+		drop_detector_show_reconnecting(d, cfg->hide_after_sec);
+	if (commands & DROP_COMMAND_HIDE_ALL)
+		drop_detector_hide_all(d);
+}
+
+double drop_detector_threshold_pct(const DropDetector *d, const DropDetectorConfig *cfg, int cause)
+{
+	if (!cfg->adaptive || cause < 0 || cause >= DROP_CAUSE_COUNT)
+		return cfg->drop_threshold_pct;
+	const DropBaseline &b = d->signals[cause].baseline;
+	return drop_baseline_ready(&b, &cfg->baseline) ? drop_baseline_threshold(&b, &cfg->baseline)
+						       : cfg->drop_threshold_pct;
+}
+
+void drop_detector_reset(DropDetector *d)
+{
+	reset_measurements(d);
+	for (DropSignal &sig : d->signals)
+		drop_baseline_reset(&sig.baseline);
+	d->reconnecting = false;
+	d->reconnect_test_sec = 0.0f;
+}
+
+void drop_detector_rebase(DropDetector *d)
+{
+	// Larger than any real counter, so the next sample takes the reset path
+	for (DropSignal &sig : d->signals) {
+		sig.prev_total = UINT64_MAX;
+		sig.prev_dropped = UINT64_MAX;
+	}
+	congestion_trend_reset(&d->trend);
+}
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Drop detection state machine. Deliberately free of libobs so it can be driven by
+// synthetic samples (see bench/) as well as by the plugin's video_tick.
+#include <stdint.h>
+#include "core/drop_baseline.hpp"
+#include "core/drop_window.hpp"
+#include "core/congestion_trend.hpp"
+
+// Why frames are being lost. When several signals trip at once the most upstream one
+// (render before encoder before network) is reported.
+enum DropCause {
+	DROP_CAUSE_NETWORK = 0, // output dropped frames
+	DROP_CAUSE_ENCODER = 1, // encoder overload, skipped frames on the video output
+	DROP_CAUSE_RENDER = 2,  // rendering lag, frames the compositor missed
+	DROP_CAUSE_COUNT,
+	DROP_CAUSE_NONE = DROP_CAUSE_COUNT,
+};
+
+// Cumulative counters of one signal ("dropped" = lost for that signal's reason)
+struct FrameCounters {
+	uint64_t total = 0;
+	uint64_t dropped = 0;
+};
+
+// Tunables, filled from the source settings
+struct DropDetectorConfig {
+	bool signal_enabled[DROP_CAUSE_COUNT] = {true, false, false};
+	double drop_threshold_pct = 1.0;      // show when pct dropped over the window >= this
+	double drop_exit_threshold_pct = 0.5; // keep showing while pct over the window >= this
+	uint32_t drop_window_ms = 1000;       // time window the drop % is measured over
+	float hide_after_sec = 3.0f;          // hide after this many seconds below the exit threshold
+	bool stable_enabled = true;
+	float stable_duration_sec = 3.0f; // how long to show after recovery
+	bool force_drop = false;          // testing: keep the dropping overlay up
+
+	// Adaptive mode: each signal's threshold comes from its own baseline once learned
+	bool adaptive = false;
+	DropBaselineConfig baseline;
+
+	// Early warning from congestion/bitrate, shown before frames actually drop
+	bool degrade_enabled = false;
+	CongestionTrendConfig trend;
+
+	bool reconnect_enabled = true; // show the reconnecting overlay while the output retries
+};
+
+// One stats sample as seen by the detector
+struct DropSample {
+	bool active = false;       // output exists and is active
+	bool reconnecting = false; // output lost its connection and is retrying
+	bool fresh = false;        // counters below were not evaluated yet
+	uint64_t timestamp_ns = 0;
+	FrameCounters counters[DROP_CAUSE_COUNT];
+	double congestion = 0.0; // obs_output_get_congestion, 0-1
+	uint64_t total_bytes = 0;
+};
+
+// Per-signal windowed drop tracking
+struct DropSignal {
+	uint64_t prev_total = 0;
+	uint64_t prev_dropped = 0;
+	double pct = 0.0; // drop % over the window as of the last sample
+	DropWindow window;
+	DropBaseline baseline; // kept across reconnects, reset when the output stops
+};
+
+// Detector state; zero-initialized is "idle"
+struct DropDetector {
+	bool auto_visible = false;
+	bool stable_visible = false;
+	int cause = DROP_CAUSE_NONE; // what the dropping overlay is about (sticky while shown)
+	float since_last_drop = 0.0f;
+	float stable_timer = 0.0f;
+	DropSignal signals[DROP_CAUSE_COUNT];
+
+	bool degrading_visible = false;
+	float since_degraded = 0.0f; // seconds since the trend last pointed at trouble
+	CongestionTrend trend;
+
+	bool reconnecting = false;
+	float reconnect_sec = 0.0f;      // time spent in the current reconnect
+	float reconnect_test_sec = 0.0f; // test button: keep reconnecting up this long
+};
+
+// Advance the state machine by one frame
+void drop_detector_tick(DropDetector *d, const DropDetectorConfig *cfg, const DropSample *sample, float seconds);
+
+// Manual overrides (Advanced test buttons)
+void drop_detector_trigger(DropDetector *d);
+void drop_detector_show_stable(DropDetector *d, const DropDetectorConfig *cfg);
+void drop_detector_show_degrading(DropDetector *d);
+void drop_detector_show_reconnecting(DropDetector *d, float hold_sec);
+void drop_detector_hide_all(DropDetector *d);
+
+// Test buttons as posted from the UI thread; bits of one frame apply in this order
+enum DropCommand {
+	DROP_COMMAND_TRIGGER = 1 << 0,
+	DROP_COMMAND_SHOW_STABLE = 1 << 1,
+	DROP_COMMAND_SHOW_DEGRADING = 1 << 2,
+	DROP_COMMAND_SHOW_RECONNECTING = 1 << 3,
+	DROP_COMMAND_HIDE_ALL = 1 << 4,
+};
+void drop_detector_apply_commands(DropDetector *d, const DropDetectorConfig *cfg, uint32_t commands);
+
+// Treat the next sample as a new baseline (e.g. after switching to other counters)
+void drop_detector_rebase(DropDetector *d);
+
+// Back to idle with the sample windows freed (e.g. a source that stopped measuring because
+// it joined a linked group)
+void drop_detector_reset(DropDetector *d);
+
+// Drop % a signal has to reach to show the overlay: the fixed threshold, or in adaptive
+// mode the learned one once its baseline is ready
+double drop_detector_threshold_pct(const DropDetector *d, const DropDetectorConfig *cfg, int cause);
+
+// Nothing on screen and nothing counting down; an inactive sample would change nothing
+static inline bool drop_detector_idle(const DropDetector *d, const DropDetectorConfig *cfg)
+{
+	return !cfg->force_drop && !d->auto_visible && !d->stable_visible && !d->degrading_visible &&
+	       !d->reconnecting;
+}
+
+static inline bool drop_detector_reconnecting_on(const DropDetector *d, const DropDetectorConfig *cfg)
+{
+	return cfg->reconnect_enabled && d->reconnecting;
+}
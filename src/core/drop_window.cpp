@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "core/drop_window.hpp"
+
+static inline uint32_t ring_index(const DropWindow *w, uint32_t i)
+{
+	return (w->head + i) % DropWindow::kCapacity;
+}
+
+void drop_window_clear(DropWindow *w)
+{
+	w->head = 0;
+	w->count = 0;
+}
+
+void drop_window_release(DropWindow *w)
+{
+	drop_window_clear(w);
+	w->ring.reset();
+}
+
+double drop_window_push(DropWindow *w, uint64_t timestamp_ns, uint64_t total, uint64_t dropped, uint64_t window_ns)
+{
+	if (!w->ring)
+		w->ring.reset(new DropWindow::Entry[DropWindow::kCapacity]);
+	// Full ring: forget the oldest sample (window gets slightly shorter)
+	if (w->count == DropWindow::kCapacity) {
+		w->head = ring_index(w, 1);
+		w->count--;
+	}
+	w->ring[ring_index(w, w->count)] = {timestamp_ns, total, dropped};
+	w->count++;
+
+	// Keep exactly one sample at or before the window start as the baseline
+	const uint64_t start = timestamp_ns > window_ns ? timestamp_ns - window_ns : 0;
+	while (w->count > 1 && w->ring[ring_index(w, 1)].timestamp_ns <= start) {
+		w->head = ring_index(w, 1);
+		w->count--;
+	}
+
+	const DropWindow::Entry &base = w->ring[w->head];
+	const uint64_t d_total = total - base.total;
+	const uint64_t d_drop = dropped - base.dropped;
+	if (d_total == 0)
+		return 0.0;
+	return (double)d_drop * 100.0 / (double)d_total;
+}
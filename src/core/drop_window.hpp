@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Sliding time window over cumulative frame counters. Samples live in a fixed ring, so
+// pushing is amortized O(1) and the drop % is a difference between two ring entries. The
+// ring (24 KB) is allocated by the first push, so signals that are never measured cost
+// nothing.
+#include <stdint.h>
+#include <memory>
+
+struct DropWindow {
+	static constexpr uint32_t kCapacity = 1024; // 10 s at the 10 ms minimum sample interval
+
+	struct Entry {
+		uint64_t timestamp_ns;
+		uint64_t total;
+		uint64_t dropped;
+	};
+
+	std::unique_ptr<Entry[]> ring; // kCapacity entries once pushed to
+	uint32_t head = 0;             // oldest entry
+	uint32_t count = 0; // entries in use
+};
+
+// Drop all samples (e.g. when the output restarted its counters)
+void drop_window_clear(DropWindow *w);
+
+// Drop all samples and free the ring
+void drop_window_release(DropWindow *w);
+
+// Append a sample and return the drop % across the last window_ns (0 when no frames)
+double drop_window_push(DropWindow *w, uint64_t timestamp_ns, uint64_t total, uint64_t dropped, uint64_t window_ns);
@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "core/incident_log.hpp"
+#include <chrono>
+#include <string.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char kMagic[8] = {'O', 'S', 'I', 'N', 'C', 'L', 'O', 'G'};
+
+static constexpr size_t kLogSize = sizeof(IncidentLogHeader) + sizeof(IncidentRecord) * kIncidentLogCapacity;
+
+// ------------------------ Mapping ------------------------
+static bool header_valid(const IncidentLogHeader *h, size_t size)
+{
+	return memcmp(h->magic, kMagic, sizeof(kMagic)) == 0 && h->version == kIncidentLogVersion &&
+	       h->record_size == sizeof(IncidentRecord) && h->capacity > 0 &&
+	       size >= sizeof(IncidentLogHeader) + (size_t)h->capacity * sizeof(IncidentRecord);
+}
+
+static void init_header(IncidentLogHeader *h)
+{
+	memset(h, 0, sizeof(*h));
+	memcpy(h->magic, kMagic, sizeof(kMagic));
+	h->version = kIncidentLogVersion;
+	h->record_size = sizeof(IncidentRecord);
+	h->capacity = kIncidentLogCapacity;
+	h->next_seq = 1;
+}
+
+#ifdef _WIN32
+static bool map_file(IncidentLog *log, const char *path, bool writable)
+{
+	wchar_t wpath[MAX_PATH];
+	if (!MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath, MAX_PATH))
+		return false;
+	HANDLE file = CreateFileW(wpath, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+				  FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, writable ? OPEN_ALWAYS : OPEN_EXISTING,
+				  FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER size;
+	GetFileSizeEx(file, &size);
+	size_t map_size = (size_t)size.QuadPart;
+	if (writable)
+		map_size = kLogSize;
+	if (map_size < sizeof(IncidentLogHeader)) {
+		CloseHandle(file);
+		return false;
+	}
+	// Mapping a writable file larger than it is grows it
+	HANDLE mapping = CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0,
+					    (DWORD)map_size, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+	void *view = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, map_size);
+	if (!view) {
+		CloseHandle(mapping);
+		return false;
+	}
+	log->header = static_cast<IncidentLogHeader *>(view);
+	log->size = map_size;
+	log->map_handle = mapping;
+	return true;
+}
+
+void incident_log_close(IncidentLog *log)
+{
+	if (log->header) {
+		UnmapViewOfFile(log->header);
+		CloseHandle(log->map_handle);
+	}
+	*log = IncidentLog{};
+}
+#else
+static bool map_file(IncidentLog *log, const char *path, bool writable)
+{
+	const int fd = open(path, writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	size_t map_size = fstat(fd, &st) == 0 ? (size_t)st.st_size : 0;
+	if (writable) {
+		if (map_size != kLogSize && ftruncate(fd, (off_t)kLogSize) != 0) {
+			close(fd);
+			return false;
+		}
+		map_size = kLogSize;
+	}
+	if (map_size < sizeof(IncidentLogHeader)) {
+		close(fd);
+		return false;
+	}
+	void *view = mmap(nullptr, map_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (view == MAP_FAILED)
+		return false;
+	log->header = static_cast<IncidentLogHeader *>(view);
+	log->size = map_size;
+	return true;
+}
+
+void incident_log_close(IncidentLog *log)
+{
+	if (log->header)
+		munmap(log->header, log->size);
+	*log = IncidentLog{};
+}
+#endif
+
+bool incident_log_open(IncidentLog *log, const char *path)
+{
+	if (!map_file(log, path, true))
+		return false;
+	// New file, older layout or garbage: start over
+	if (!header_valid(log->header, log->size)) {
+		memset(log->header, 0, log->size);
+		init_header(log->header);
+	}
+	log->records = reinterpret_cast<IncidentRecord *>(log->header + 1);
+	log->writable = true;
+	return true;
+}
+
+bool incident_log_open_readonly(IncidentLog *log, const char *path)
+{
+	if (!map_file(log, path, false))
+		return false;
+	if (!header_valid(log->header, log->size)) {
+		incident_log_close(log);
+		return false;
+	}
+	log->records = reinterpret_cast<IncidentRecord *>(log->header + 1);
+	return true;
+}
+
+// ------------------------ Records ------------------------
+IncidentRecord *incident_log_record(IncidentLog *log, uint64_t seq)
+{
+	if (!log->header || seq == 0)
+		return nullptr;
+	const uint32_t capacity = log->header->capacity;
+	if (seq >= log->header->next_seq || log->header->next_seq - seq > capacity)
+		return nullptr;
+	IncidentRecord *rec = &log->records[(seq - 1) % capacity];
+	return rec->seq == seq ? rec : nullptr;
+}
+
+static void copy_label(char *dst, size_t size, const char *src)
+{
+	size_t n = src ? strlen(src) : 0;
+	if (n >= size)
+		n = size - 1;
+	if (n)
+		memcpy(dst, src, n);
+	memset(dst + n, 0, size - n);
+}
+
+uint64_t incident_log_begin(IncidentLog *log, int kind, int cause, const char *output, const char *source)
+{
+	if (!log->writable)
+		return 0;
+	IncidentLogHeader *h = log->header;
+	const uint64_t seq = h->next_seq;
+	IncidentRecord *rec = &log->records[(seq - 1) % h->capacity];
+
+	// Invalidate the slot first so a crash mid-write never leaves a mix of two records
+	rec->seq = 0;
+	rec->start_ms = incident_log_now_ms();
+	rec->end_ms = 0;
+	rec->dropped_frames = 0;
+	rec->total_frames = 0;
+	rec->peak_pct = 0.0f;
+	rec->kind = (uint8_t)kind;
+	rec->cause = (uint8_t)cause;
+	memset(rec->reserved, 0, sizeof(rec->reserved));
+	copy_label(rec->output, sizeof(rec->output), output);
+	copy_label(rec->source, sizeof(rec->source), source);
+	rec->seq = seq;
+	h->next_seq = seq + 1;
+	return seq;
+}
+
+uint64_t incident_log_now_ms(void)
+{
+	using namespace std::chrono;
+	return (uint64_t)duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// ------------------------ Tracker ------------------------
+// Callers may stop feeding the tracker between episodes, so the next one starts from its
+// own first fresh sample instead of counting everything sent meanwhile
+static void end_record(IncidentTracker *t, IncidentLog *log)
+{
+	if (IncidentRecord *rec = incident_log_record(log, t->seq))
+		rec->end_ms = incident_log_now_ms();
+	t->seq = 0;
+	t->have_last = false;
+}
+
+int incident_kind(const DropDetector *d)
+{
+	if (d->reconnecting)
+		return INCIDENT_RECONNECTING;
+	if (d->auto_visible)
+		return INCIDENT_DROPPING;
+	return -1;
+}
+
+void incident_tracker_tick(IncidentTracker *t, IncidentLog *log, int kind, const DropDetector *d,
+			   const DropSample *sample, const char *output, const char *source)
+{
+	if (!log || !log->writable)
+		return;
+
+	if (t->seq && kind != t->kind)
+		end_record(t, log);
+	if (kind >= 0 && !t->seq) {
+		const int cause = kind == INCIDENT_DROPPING ? d->cause : DROP_CAUSE_NONE;
+		t->seq = incident_log_begin(log, kind, cause, output, source);
+		t->kind = kind;
+	}
+	// Counters are only followed during an episode, see end_record
+	if (!t->seq)
+		return;
+
+	// Frames lost meanwhile, from counter deltas of fresh samples
+	FrameCounters delta[DROP_CAUSE_COUNT] = {};
+	if (sample->fresh) {
+		for (int c = 0; c < DROP_CAUSE_COUNT; c++) {
+			const FrameCounters &now = sample->counters[c];
+			const FrameCounters &prev = t->last[c];
+			// Counters restarted: nothing to compare with yet
+			if (t->have_last && now.total >= prev.total && now.dropped >= prev.dropped) {
+				delta[c].total = now.total - prev.total;
+				delta[c].dropped = now.dropped - prev.dropped;
+			}
+			t->last[c] = now;
+		}
+		t->have_last = sample->active;
+	}
+
+	if (t->kind != INCIDENT_DROPPING)
+		return;
+	IncidentRecord *rec = incident_log_record(log, t->seq);
+	if (!rec) {
+		// Overwritten by a wrap of the ring; nothing left to update
+		t->seq = 0;
+		return;
+	}
+	if (d->cause < DROP_CAUSE_COUNT) {
+		const float pct = (float)d->signals[d->cause].pct;
+		if (pct > rec->peak_pct) {
+			rec->peak_pct = pct;
+			rec->cause = (uint8_t)d->cause;
+		}
+		rec->dropped_frames += delta[d->cause].dropped;
+		rec->total_frames += delta[d->cause].total;
+	}
+}
+
+void incident_tracker_end(IncidentTracker *t, IncidentLog *log)
+{
+	if (t->seq && log)
+		end_record(t, log);
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Persistent incident log: a fixed-size file mapped into memory, holding a ring of episode
+// records. Writers only store into the mapping (no syscall per frame); the OS writes the
+// pages back, so the log survives OBS crashing mid-stream. Free of libobs so the offline
+// reader in tools/ can share it.
+#include <stddef.h>
+#include <stdint.h>
+#include "core/drop_detector.hpp"
+
+// What an episode is about
+enum IncidentKind {
+	INCIDENT_DROPPING = 0,     // dropping overlay was up
+	INCIDENT_RECONNECTING = 1, // output lost its connection
+	INCIDENT_KIND_COUNT
+};
+
+// One episode. Written when it starts and updated in place until it ends.
+struct IncidentRecord {
+	uint64_t seq;            // 1-based write number; 0 = slot never written
+	uint64_t start_ms;       // wall clock, ms since the Unix epoch
+	uint64_t end_ms;         // 0 while the episode is open (or OBS exited during it)
+	uint64_t dropped_frames; // frames lost to the episode's cause meanwhile
+	uint64_t total_frames;   // frames counted for that cause meanwhile
+	float peak_pct;          // highest windowed drop %
+	uint8_t kind;            // IncidentKind
+	uint8_t cause;           // DropCause of the peak, DROP_CAUSE_NONE for reconnects
+	uint8_t reserved[2];
+	char output[16]; // watched output(s), NUL-terminated
+	char source[32]; // source that logged it, NUL-terminated
+};
+static_assert(sizeof(IncidentRecord) == 96, "incident record layout is part of the file format");
+
+struct IncidentLogHeader {
+	char magic[8]; // "OSINCLOG"
+	uint32_t version;
+	uint32_t record_size;
+	uint32_t capacity; // records in the ring
+	uint32_t reserved0;
+	uint64_t next_seq; // seq of the next record
+	uint8_t reserved[32];
+};
+static_assert(sizeof(IncidentLogHeader) == 64, "incident log header layout is part of the file format");
+
+static constexpr uint32_t kIncidentLogVersion = 1;
+static constexpr uint32_t kIncidentLogCapacity = 4096; // ~384 KiB
+
+// A mapped log file
+struct IncidentLog {
+	IncidentLogHeader *header = nullptr;
+	IncidentRecord *records = nullptr;
+	size_t size = 0;
+	void *map_handle = nullptr; // file mapping (Windows)
+	bool writable = false;
+};
+
+// Map a log for writing, creating it or starting it over when the file is not a valid log
+bool incident_log_open(IncidentLog *log, const char *path);
+
+// Map an existing log read-only (offline reader)
+bool incident_log_open_readonly(IncidentLog *log, const char *path);
+
+void incident_log_close(IncidentLog *log);
+
+// Record of a seq, nullptr once the ring has wrapped over it
+IncidentRecord *incident_log_record(IncidentLog *log, uint64_t seq);
+
+// Start a record in the next ring slot; returns its seq
+uint64_t incident_log_begin(IncidentLog *log, int kind, int cause, const char *output, const char *source);
+
+// Milliseconds since the Unix epoch
+uint64_t incident_log_now_ms(void);
+
+// Episode a detector shows: an IncidentKind, or -1 for none. Reconnects take precedence,
+// like on screen.
+int incident_kind(const DropDetector *d);
+
+// Turns the episodes of one watched output into records
+struct IncidentTracker {
+	uint64_t seq = 0; // open record (0 = none)
+	int kind = INCIDENT_DROPPING;
+	FrameCounters last[DROP_CAUSE_COUNT]; // counters at the previous fresh sample
+	bool have_last = false;
+};
+
+// Call after drop_detector_tick with the same sample; kind is the episode to record (-1 =
+// none), d gives the cause and drop %. Several detectors watching the same output may feed
+// one tracker: a sample already counted adds no frames. It need not be fed between
+// episodes; each one counts from its own first fresh sample. Only touches the mapping while an
+// episode is open, and only reads the clock when one starts or ends.
+void incident_tracker_tick(IncidentTracker *t, IncidentLog *log, int kind, const DropDetector *d,
+			   const DropSample *sample, const char *output, const char *source);
+
+// Close the open record, if any (source going away)
+void incident_tracker_end(IncidentTracker *t, IncidentLog *log);
@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "core/sample_trace.hpp"
+#include <string.h>
+
+static const char kMagic[8] = {'O', 'S', 'S', 'M', 'P', 'T', 'R', 'C'};
+
+// Config flag bits, in the first byte of a config block
+enum ConfigBits {
+	CONFIG_STABLE = 1 << 3, // bits 0-2: signal_enabled
+	CONFIG_FORCE_DROP = 1 << 4,
+	CONFIG_ADAPTIVE = 1 << 5,
+	CONFIG_DEGRADE = 1 << 6,
+	CONFIG_RECONNECT = 1 << 7,
+};
+
+// ------------------------ Encoding ------------------------
+template<typename T> static inline void put(std::vector<uint8_t> *out, T value)
+{
+	uint8_t bytes[sizeof(T)];
+	memcpy(bytes, &value, sizeof(T));
+	out->insert(out->end(), bytes, bytes + sizeof(T));
+}
+
+static inline void put_varint(std::vector<uint8_t> *out, uint64_t value)
+{
+	while (value >= 0x80) {
+		out->push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	out->push_back((uint8_t)value);
+}
+
+// Counters may go backwards when OBS restarts its stats
+static inline void put_delta(std::vector<uint8_t> *out, uint64_t value, uint64_t prev)
+{
+	const int64_t delta = (int64_t)(value - prev);
+	put_varint(out, ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63));
+}
+
+static void put_config(std::vector<uint8_t> *out, const DropDetectorConfig *cfg)
+{
+	uint8_t bits = 0;
+	for (int c = 0; c < DROP_CAUSE_COUNT; c++)
+		bits |= cfg->signal_enabled[c] ? (uint8_t)(1 << c) : 0;
+	bits |= cfg->stable_enabled ? CONFIG_STABLE : 0;
+	bits |= cfg->force_drop ? CONFIG_FORCE_DROP : 0;
+	bits |= cfg->adaptive ? CONFIG_ADAPTIVE : 0;
+	bits |= cfg->degrade_enabled ? CONFIG_DEGRADE : 0;
+	bits |= cfg->reconnect_enabled ? CONFIG_RECONNECT : 0;
+	out->push_back(bits);
+	put(out, cfg->drop_threshold_pct);
+	put(out, cfg->drop_exit_threshold_pct);
+	put(out, cfg->drop_window_ms);
+	put(out, cfg->hide_after_sec);
+	put(out, cfg->stable_duration_sec);
+	put(out, cfg->baseline.quantile);
+	put(out, cfg->baseline.learn_sec);
+	put(out, cfg->baseline.half_life_sec);
+	put(out, cfg->baseline.min_pct);
+	put(out, cfg->trend.congestion_pct);
+	put(out, cfg->trend.slope_pct_per_sec);
+	put(out, cfg->trend.bitrate_drop_pct);
+	put(out, cfg->trend.smoothing_sec);
+}
+
+void sample_trace_write_header(std::vector<uint8_t> *out, uint64_t start_ms)
+{
+	SampleTraceHeader h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, kMagic, sizeof(kMagic));
+	h.version = kSampleTraceVersion;
+	h.start_ms = start_ms;
+	const auto *bytes = reinterpret_cast<const uint8_t *>(&h);
+	out->insert(out->end(), bytes, bytes + sizeof(h));
+}
+
+void sample_trace_write_tick(SampleTraceWriter *w, std::vector<uint8_t> *out, float seconds, float idle_sec,
+			     uint32_t commands, bool rebase, const DropDetectorConfig *config,
+			     const DropSample *sample)
+{
+	uint8_t flags = 0;
+	flags |= sample->active ? SAMPLE_TRACE_ACTIVE : 0;
+	flags |= sample->reconnecting ? SAMPLE_TRACE_RECONNECTING : 0;
+	flags |= sample->fresh ? SAMPLE_TRACE_FRESH : 0;
+	flags |= idle_sec > 0.0f ? SAMPLE_TRACE_IDLE : 0;
+	flags |= config ? SAMPLE_TRACE_CONFIG : 0;
+	flags |= commands ? SAMPLE_TRACE_COMMANDS : 0;
+	flags |= rebase ? SAMPLE_TRACE_REBASE : 0;
+	out->push_back(flags);
+	put(out, seconds);
+	if (flags & SAMPLE_TRACE_IDLE)
+		put(out, idle_sec);
+	if (config)
+		put_config(out, config);
+	if (commands)
+		out->push_back((uint8_t)commands);
+	if (!sample->fresh)
+		return;
+
+	DropSample &last = w->last;
+	put_delta(out, sample->timestamp_ns, last.timestamp_ns);
+	for (int c = 0; c < DROP_CAUSE_COUNT; c++) {
+		put_delta(out, sample->counters[c].total, last.counters[c].total);
+		put_delta(out, sample->counters[c].dropped, last.counters[c].dropped);
+	}
+	put(out, sample->congestion);
+	put_delta(out, sample->total_bytes, last.total_bytes);
+	last = *sample;
+}
+
+// ------------------------ Decoding ------------------------
+template<typename T> static inline bool get(SampleTraceReader *r, T *value)
+{
+	if (r->size - r->pos < sizeof(T))
+		return false;
+	memcpy(value, r->data + r->pos, sizeof(T));
+	r->pos += sizeof(T);
+	return true;
+}
+
+static inline bool get_varint(SampleTraceReader *r, uint64_t *value)
+{
+	uint64_t result = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (r->pos >= r->size)
+			return false;
+		const uint8_t byte = r->data[r->pos++];
+		result |= (uint64_t)(byte & 0x7f) << shift;
+		if (!(byte & 0x80)) {
+			*value = result;
+			return true;
+		}
+	}
+	return false;
+}
+
+static inline bool get_delta(SampleTraceReader *r, uint64_t *value)
+{
+	uint64_t zigzag;
+	if (!get_varint(r, &zigzag))
+		return false;
+	*value += (zigzag >> 1) ^ (uint64_t)-(int64_t)(zigzag & 1);
+	return true;
+}
+
+static bool get_config(SampleTraceReader *r, DropDetectorConfig *cfg)
+{
+	uint8_t bits;
+	if (!get(r, &bits))
+		return false;
+	for (int c = 0; c < DROP_CAUSE_COUNT; c++)
+		cfg->signal_enabled[c] = (bits & (1 << c)) != 0;
+	cfg->stable_enabled = (bits & CONFIG_STABLE) != 0;
+	cfg->force_drop = (bits & CONFIG_FORCE_DROP) != 0;
+	cfg->adaptive = (bits & CONFIG_ADAPTIVE) != 0;
+	cfg->degrade_enabled = (bits & CONFIG_DEGRADE) != 0;
+	cfg->reconnect_enabled = (bits & CONFIG_RECONNECT) != 0;
+	return get(r, &cfg->drop_threshold_pct) && get(r, &cfg->drop_exit_threshold_pct) &&
+	       get(r, &cfg->drop_window_ms) && get(r, &cfg->hide_after_sec) && get(r, &cfg->stable_duration_sec) &&
+	       get(r, &cfg->baseline.quantile) && get(r, &cfg->baseline.learn_sec) &&
+	       get(r, &cfg->baseline.half_life_sec) && get(r, &cfg->baseline.min_pct) &&
+	       get(r, &cfg->trend.congestion_pct) && get(r, &cfg->trend.slope_pct_per_sec) &&
+	       get(r, &cfg->trend.bitrate_drop_pct) && get(r, &cfg->trend.smoothing_sec);
+}
+
+bool sample_trace_reader_init(SampleTraceReader *r, const uint8_t *data, size_t size)
+{
+	*r = SampleTraceReader{};
+	SampleTraceHeader h;
+	if (size < sizeof(h))
+		return false;
+	memcpy(&h, data, sizeof(h));
+	if (memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kSampleTraceVersion)
+		return false;
+	r->data = data;
+	r->size = size;
+	r->pos = sizeof(h);
+	r->start_ms = h.start_ms;
+	return true;
+}
+
+int sample_trace_read(SampleTraceReader *r, SampleTraceTick *tick)
+{
+	if (r->pos >= r->size)
+		return SAMPLE_TRACE_READ_END;
+	const size_t start = r->pos;
+	uint8_t flags;
+	bool ok = get(r, &flags) && get(r, &tick->seconds);
+	tick->idle_sec = 0.0f;
+	if (ok && (flags & SAMPLE_TRACE_IDLE))
+		ok = get(r, &tick->idle_sec);
+	tick->has_config = ok && (flags & SAMPLE_TRACE_CONFIG);
+	if (tick->has_config)
+		ok = get_config(r, &tick->config);
+	uint8_t commands = 0;
+	if (ok && (flags & SAMPLE_TRACE_COMMANDS))
+		ok = get(r, &commands);
+	tick->commands = commands;
+	tick->rebase = (flags & SAMPLE_TRACE_REBASE) != 0;
+
+	DropSample next = r->last;
+	if (ok && (flags & SAMPLE_TRACE_FRESH)) {
+		ok = get_delta(r, &next.timestamp_ns);
+		for (int c = 0; ok && c < DROP_CAUSE_COUNT; c++)
+			ok = get_delta(r, &next.counters[c].total) && get_delta(r, &next.counters[c].dropped);
+		ok = ok && get(r, &next.congestion) && get_delta(r, &next.total_bytes);
+	}
+	if (!ok) {
+		r->pos = start;
+		return SAMPLE_TRACE_READ_TRUNCATED;
+	}
+	next.active = (flags & SAMPLE_TRACE_ACTIVE) != 0;
+	next.reconnecting = (flags & SAMPLE_TRACE_RECONNECTING) != 0;
+	next.fresh = (flags & SAMPLE_TRACE_FRESH) != 0;
+	if (next.fresh)
+		r->last = next;
+	tick->sample = next;
+	return SAMPLE_TRACE_READ_OK;
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Sample trace: everything the drop detector was fed, tick by tick (samples, frame times,
+// settings and test buttons), so a stream can be replayed through drop_detector_tick()
+// offline with the same result. Free of libobs so the replay tool in tools/ can share it.
+//
+// File: a SampleTraceHeader, then one variable-length record per tick. A record starts with
+// a SampleTraceFlags byte and the tick's seconds (float); the optional parts follow in flag
+// order. Counters are stored as zigzag varint deltas from the previous fresh sample of the
+// file, so a tick without a new sample takes 5 bytes and a fresh one about 25.
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "core/drop_detector.hpp"
+
+struct SampleTraceHeader {
+	char magic[8]; // "OSSMPTRC"
+	uint32_t version;
+	uint32_t reserved0;
+	uint64_t start_ms; // wall clock when the file was started, ms since the Unix epoch
+	uint8_t reserved[8];
+};
+static_assert(sizeof(SampleTraceHeader) == 32, "sample trace header layout is part of the file format");
+
+static constexpr uint32_t kSampleTraceVersion = 1;
+
+enum SampleTraceFlags {
+	SAMPLE_TRACE_ACTIVE = 1 << 0,
+	SAMPLE_TRACE_RECONNECTING = 1 << 1,
+	SAMPLE_TRACE_FRESH = 1 << 2,    // counters, timestamp, congestion and bytes follow
+	SAMPLE_TRACE_IDLE = 1 << 3,     // seconds skipped without ticking the detector follow
+	SAMPLE_TRACE_CONFIG = 1 << 4,   // settings changed; the detector config follows
+	SAMPLE_TRACE_COMMANDS = 1 << 5, // DropCommand bits applied before this tick follow
+	SAMPLE_TRACE_REBASE = 1 << 6,   // drop_detector_rebase() ran before this tick (output switched)
+};
+
+// One tick as the detector saw it
+struct SampleTraceTick {
+	float seconds = 0.0f;
+	float idle_sec = 0.0f; // time before this tick the source skipped as idle
+	uint32_t commands = 0; // DropCommand bits
+	bool rebase = false;   // rebase the detector before the commands and the tick
+	bool has_config = false;
+	DropDetectorConfig config; // valid when has_config; the last one applies otherwise
+	DropSample sample;         // counters of the last fresh sample when not fresh
+};
+
+// Encoder state of one file; value-initialize at the start of every file
+struct SampleTraceWriter {
+	DropSample last;
+};
+
+void sample_trace_write_header(std::vector<uint8_t> *out, uint64_t start_ms);
+
+// Append one tick. config is nullptr when the settings did not change since the last tick.
+void sample_trace_write_tick(SampleTraceWriter *w, std::vector<uint8_t> *out, float seconds, float idle_sec,
+			     uint32_t commands, bool rebase, const DropDetectorConfig *config,
+			     const DropSample *sample);
+
+enum SampleTraceRead {
+	SAMPLE_TRACE_READ_OK = 0,
+	SAMPLE_TRACE_READ_END = 1,       // no more ticks
+	SAMPLE_TRACE_READ_TRUNCATED = 2, // the last tick was cut off (e.g. OBS exited mid-write)
+};
+
+// Decoder over a file loaded into memory
+struct SampleTraceReader {
+	const uint8_t *data = nullptr;
+	size_t size = 0;
+	size_t pos = 0;
+	uint64_t start_ms = 0;
+	DropSample last;
+};
+
+// False when data is not a sample trace of a known version
+bool sample_trace_reader_init(SampleTraceReader *r, const uint8_t *data, size_t size);
+
+// Decode the next tick into *tick; returns a SampleTraceRead
+int sample_trace_read(SampleTraceReader *r, SampleTraceTick *tick);
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "core/sparkline.hpp"
+
+// Which sample counters feed the percentage series
+static const int kSeriesCause[SPARKLINE_LAG + 1] = {DROP_CAUSE_NETWORK, DROP_CAUSE_RENDER};
+
+void sparkline_reset(SparklineHistory *h, float span_sec)
+{
+	if (span_sec < 1.0f)
+		span_sec = 1.0f;
+	*h = SparklineHistory{};
+	h->point_ns = (uint64_t)((double)span_sec * 1e9 / kSparklinePoints);
+}
+
+static void commit_point(SparklineHistory *h, bool empty)
+{
+	for (int s = SPARKLINE_DROP; s <= SPARKLINE_LAG; s++) {
+		const FrameCounters &c = h->acc[s];
+		const bool measured = !empty && c.total;
+		h->values[s][h->head] = measured ? (float)((double)c.dropped * 100.0 / (double)c.total) : 0.0f;
+		h->acc[s] = FrameCounters{};
+	}
+	const double sec = (double)h->point_ns / 1e9;
+	h->values[SPARKLINE_BITRATE][h->head] = empty ? 0.0f : (float)((double)h->acc_bytes * 8.0 / 1000.0 / sec);
+	h->acc_bytes = 0;
+
+	h->head = (h->head + 1) % kSparklinePoints;
+	if (h->count < kSparklinePoints)
+		h->count++;
+	h->gen++;
+}
+
+void sparkline_push(SparklineHistory *h, const DropSample *sample)
+{
+	if (!sample->fresh)
+		return;
+	if (!sample->active) {
+		h->have_last = false;
+		return;
+	}
+
+	// Counters that went backwards were restarted; the delta is unknown
+	for (int s = SPARKLINE_DROP; s <= SPARKLINE_LAG; s++) {
+		const FrameCounters &now = sample->counters[kSeriesCause[s]];
+		const FrameCounters &prev = h->last[s];
+		if (h->have_last && now.total >= prev.total && now.dropped >= prev.dropped) {
+			h->acc[s].total += now.total - prev.total;
+			h->acc[s].dropped += now.dropped - prev.dropped;
+		}
+		h->last[s] = now;
+	}
+	if (h->have_last && sample->total_bytes >= h->last_bytes)
+		h->acc_bytes += sample->total_bytes - h->last_bytes;
+	h->last_bytes = sample->total_bytes;
+	h->have_last = true;
+
+	const uint64_t ts = sample->timestamp_ns;
+	if (!h->point_end_ns) {
+		h->point_end_ns = ts + h->point_ns;
+		return;
+	}
+	if (ts < h->point_end_ns)
+		return;
+
+	commit_point(h, false);
+	uint64_t missed = (ts - h->point_end_ns) / h->point_ns;
+	if (missed >= kSparklinePoints) {
+		// Longer gap than the whole graph: blank it and start the next point here
+		for (uint32_t i = 0; i < kSparklinePoints; i++)
+			commit_point(h, true);
+		h->point_end_ns = ts + h->point_ns;
+		return;
+	}
+	for (uint64_t i = 0; i < missed; i++)
+		commit_point(h, true);
+	h->point_end_ns += (missed + 1) * h->point_ns;
+}
+
+float sparkline_max(const SparklineHistory *h, int series)
+{
+	float max = 0.0f;
+	for (uint32_t i = 0; i < kSparklinePoints; i++)
+		if (h->values[series][i] > max)
+			max = h->values[series][i];
+	return max;
+}
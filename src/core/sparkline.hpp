@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// History behind the graph content mode: a fixed ring of points, each one the drop %,
+// rendering lag % and bitrate over an equal slice of the graphed span. Points are built
+// from counter deltas of fresh samples, so the graph does not depend on which causes the
+// detector watches. Free of libobs, like the detector.
+#include <stdint.h>
+#include "core/drop_detector.hpp"
+
+static constexpr uint32_t kSparklinePoints = 120;
+
+enum SparklineSeries {
+	SPARKLINE_DROP = 0,    // network drop %
+	SPARKLINE_LAG = 1,     // rendering lag %
+	SPARKLINE_BITRATE = 2, // kbps
+	SPARKLINE_SERIES_COUNT
+};
+
+struct SparklineHistory {
+	// Ring of points per series
+	float values[SPARKLINE_SERIES_COUNT][kSparklinePoints] = {};
+	uint32_t head = 0;                // slot of the next point
+	uint32_t count = 0;               // points written, up to kSparklinePoints
+	uint64_t gen = 0;                 // bumped with every point
+	uint64_t point_ns = 250000000ULL; // time one point covers
+
+	// Point being accumulated
+	uint64_t point_end_ns = 0; // 0 = no sample yet
+	FrameCounters acc[SPARKLINE_LAG + 1];
+	uint64_t acc_bytes = 0;
+
+	// Previous fresh sample
+	bool have_last = false;
+	FrameCounters last[SPARKLINE_LAG + 1];
+	uint64_t last_bytes = 0;
+};
+
+// Clear the history and graph span_sec seconds from now on
+void sparkline_reset(SparklineHistory *h, float span_sec);
+
+// Fold in a sample (call every tick; only fresh samples count). Stretches without samples,
+// such as a stream restart, are graphed as zeros.
+void sparkline_push(SparklineHistory *h, const DropSample *sample);
+
+// Point i of the last kSparklinePoints, 0 = oldest; 0 where there is no history yet
+static inline float sparkline_value(const SparklineHistory *h, int series, uint32_t i)
+{
+	if (i < kSparklinePoints - h->count)
+		return 0.0f;
+	return h->values[series][(h->head + i) % kSparklinePoints];
+}
+
+// Largest value of a series in the history
+float sparkline_max(const SparklineHistory *h, int series);
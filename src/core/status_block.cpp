@@ -0,0 +1,288 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "core/status_block.hpp"
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char kMagic[8] = {'O', 'S', 'S', 'T', 'A', 'T', 'U', 'S'};
+
+static constexpr size_t kBlockSize = sizeof(StatusBlockHeader) + sizeof(StatusEntry) * kStatusEntryCount;
+
+// Reads that keep overlapping a write give up after this many attempts
+static constexpr int kReadAttempts = 64;
+
+// ------------------------ Mapping ------------------------
+static bool header_valid(const StatusBlockHeader *h, size_t size)
+{
+	return memcmp(h->magic, kMagic, sizeof(kMagic)) == 0 && h->version == kStatusBlockVersion &&
+	       h->entry_size == sizeof(StatusEntry) &&
+	       size >= sizeof(StatusBlockHeader) + (size_t)h->entry_count * sizeof(StatusEntry);
+}
+
+#ifdef _WIN32
+static void mapping_name(wchar_t *out, size_t size, uint32_t pid)
+{
+	if (pid)
+		_snwprintf_s(out, size, _TRUNCATE, L"Local\\online-status-%u", pid);
+	else
+		_snwprintf_s(out, size, _TRUNCATE, L"Local\\online-status");
+}
+
+static bool map_view(StatusBlock *block, HANDLE mapping, bool writable)
+{
+	void *view = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		return false;
+	}
+	MEMORY_BASIC_INFORMATION info;
+	VirtualQuery(view, &info, sizeof(info));
+	block->header = static_cast<StatusBlockHeader *>(view);
+	block->size = info.RegionSize;
+	block->map_handle = mapping;
+	return true;
+}
+
+static bool map_block(StatusBlock *block, uint32_t pid)
+{
+	wchar_t name[64];
+	mapping_name(name, 64, pid);
+	HANDLE mapping = OpenFileMappingW(FILE_MAP_READ, FALSE, name);
+	if (!mapping)
+		return false;
+	block->name_pid = pid;
+	return map_view(block, mapping, false);
+}
+
+void status_block_close(StatusBlock *block, bool /*remove*/)
+{
+	// The mapping goes away with its last handle
+	if (block->header) {
+		UnmapViewOfFile(block->header);
+		CloseHandle(block->map_handle);
+	}
+	*block = StatusBlock{};
+}
+
+static uint32_t current_pid(void)
+{
+	return (uint32_t)GetCurrentProcessId();
+}
+
+static bool process_alive(uint32_t pid)
+{
+	HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, pid);
+	if (!process)
+		return GetLastError() == ERROR_ACCESS_DENIED;
+	const bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+	CloseHandle(process);
+	return alive;
+}
+
+static bool owned_by_other(const StatusBlock *block);
+
+// Writable mapping of kBlockSize. *busy when another running process publishes under the name.
+static bool claim_block(StatusBlock *block, uint32_t pid, bool *busy)
+{
+	*busy = false;
+	wchar_t name[64];
+	mapping_name(name, 64, pid);
+	HANDLE mapping =
+		CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, (DWORD)kBlockSize, name);
+	if (!mapping)
+		return false;
+	const bool existed = GetLastError() == ERROR_ALREADY_EXISTS;
+	if (!map_view(block, mapping, true))
+		return false;
+	block->name_pid = pid;
+	// Mappings cannot be removed by name; an older layout that is too small is unusable
+	if (existed && (owned_by_other(block) || block->size < kBlockSize)) {
+		*busy = true;
+		status_block_close(block, false);
+		return false;
+	}
+	return true;
+}
+#else
+static void shm_name(char *out, size_t size, uint32_t pid)
+{
+	if (pid)
+		snprintf(out, size, "/online-status-%u", pid);
+	else
+		snprintf(out, size, "/online-status");
+}
+
+static bool map_fd(StatusBlock *block, int fd, size_t map_size, bool writable)
+{
+	if (map_size < sizeof(StatusBlockHeader)) {
+		close(fd);
+		return false;
+	}
+	void *view = mmap(nullptr, map_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (view == MAP_FAILED)
+		return false;
+	block->header = static_cast<StatusBlockHeader *>(view);
+	block->size = map_size;
+	return true;
+}
+
+static bool map_block(StatusBlock *block, uint32_t pid)
+{
+	char name[64];
+	shm_name(name, sizeof(name), pid);
+	const int fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	block->name_pid = pid;
+	return map_fd(block, fd, fstat(fd, &st) == 0 ? (size_t)st.st_size : 0, false);
+}
+
+void status_block_close(StatusBlock *block, bool remove)
+{
+	if (block->header)
+		munmap(block->header, block->size);
+	if (block->header && remove) {
+		char name[64];
+		shm_name(name, sizeof(name), block->name_pid);
+		shm_unlink(name);
+	}
+	*block = StatusBlock{};
+}
+
+static uint32_t current_pid(void)
+{
+	return (uint32_t)getpid();
+}
+
+static bool process_alive(uint32_t pid)
+{
+	return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+}
+
+static bool owned_by_other(const StatusBlock *block);
+
+// Writable mapping of kBlockSize. *busy when another running process publishes under the name.
+static bool claim_block(StatusBlock *block, uint32_t pid, bool *busy)
+{
+	*busy = false;
+	char name[64];
+	shm_name(name, sizeof(name), pid);
+	StatusBlock old;
+	if (map_block(&old, pid)) {
+		*busy = owned_by_other(&old);
+		status_block_close(&old, false);
+		if (*busy)
+			return false;
+	}
+	// Left behind by a process that is gone: replace it rather than resize it under a reader
+	shm_unlink(name);
+	const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+	if (fd < 0) {
+		*busy = errno == EEXIST; // another instance claimed it in the meantime
+		return false;
+	}
+	if (ftruncate(fd, (off_t)kBlockSize) != 0) {
+		close(fd);
+		shm_unlink(name);
+		return false;
+	}
+	block->name_pid = pid;
+	return map_fd(block, fd, kBlockSize, true);
+}
+#endif
+
+static bool owned_by_other(const StatusBlock *block)
+{
+	const StatusBlockHeader *h = block->header;
+	// Magic and pid are the first fields of every layout version
+	if (block->size < sizeof(StatusBlockHeader) || memcmp(h->magic, kMagic, sizeof(kMagic)) != 0)
+		return false;
+	return h->pid != current_pid() && process_alive(h->pid);
+}
+
+bool status_block_create(StatusBlock *block)
+{
+	bool busy = false;
+	if (!claim_block(block, 0, &busy) && (!busy || !claim_block(block, current_pid(), &busy)))
+		return false;
+	// Whatever was there belonged to a process that is gone; start over
+	memset(static_cast<void *>(block->header), 0, block->size);
+	StatusBlockHeader *h = block->header;
+	memcpy(h->magic, kMagic, sizeof(kMagic));
+	h->version = kStatusBlockVersion;
+	h->entry_size = sizeof(StatusEntry);
+	h->entry_count = kStatusEntryCount;
+	h->pid = current_pid();
+	block->entries = reinterpret_cast<StatusEntry *>(h + 1);
+	return true;
+}
+
+bool status_block_open_readonly(StatusBlock *block, uint32_t pid)
+{
+	if (!map_block(block, pid))
+		return false;
+	if (!header_valid(block->header, block->size)) {
+		status_block_close(block, false);
+		return false;
+	}
+	block->entries = reinterpret_cast<StatusEntry *>(block->header + 1);
+	return true;
+}
+
+// ------------------------ Entries ------------------------
+bool status_entry_write(StatusEntry *entry, const StatusValues *values, const char *name)
+{
+	uint32_t seq = entry->seq.load(std::memory_order_relaxed);
+	if ((seq & 1) || !entry->seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire))
+		return false;
+	// Field stores must not become visible before the counter turned odd
+	std::atomic_thread_fence(std::memory_order_release);
+
+	entry->state.store(values->state, std::memory_order_relaxed);
+	entry->cause.store(values->cause, std::memory_order_relaxed);
+	entry->drop_pct.store(values->drop_pct, std::memory_order_relaxed);
+	entry->episode.store(values->episode, std::memory_order_relaxed);
+	entry->incident_seq.store(values->incident_seq, std::memory_order_relaxed);
+	if (name) {
+		const size_t n = strnlen(name, sizeof(entry->name) - 1);
+		memcpy(entry->name, name, n);
+		memset(entry->name + n, 0, sizeof(entry->name) - n);
+	}
+
+	entry->seq.store(seq + 2, std::memory_order_release);
+	return true;
+}
+
+bool status_entry_read(const StatusEntry *entry, StatusValues *values, char name[32])
+{
+	for (int attempt = 0; attempt < kReadAttempts; attempt++) {
+		const uint32_t seq = entry->seq.load(std::memory_order_acquire);
+		if (seq & 1)
+			continue;
+		values->state = entry->state.load(std::memory_order_relaxed);
+		values->cause = entry->cause.load(std::memory_order_relaxed);
+		values->drop_pct = entry->drop_pct.load(std::memory_order_relaxed);
+		values->episode = entry->episode.load(std::memory_order_relaxed);
+		values->incident_seq = entry->incident_seq.load(std::memory_order_relaxed);
+		memcpy(name, entry->name, sizeof(entry->name));
+		// Field loads must complete before the counter is checked again
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (entry->seq.load(std::memory_order_relaxed) == seq) {
+			name[sizeof(entry->name) - 1] = '\0';
+			return true;
+		}
+	}
+	return false;
+}
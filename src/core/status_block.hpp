@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Live status for external readers (stream decks, tally lights): a fixed-layout block in
+// shared memory with one entry per source. Every entry is a seqlock. A writer makes its
+// counter odd with a compare-exchange, stores the fields and makes it even again, so a
+// reader never blocks the writer and a busy entry only makes the writer skip a tick.
+// Free of libobs so the reader in tools/ (or any other program) can share it.
+//
+// POSIX: shm_open("/online-status"), Windows: the named mapping "Local\online-status".
+// A second OBS instance finds that name taken by a live publisher and appends its pid
+// ("/online-status-1234"); readers pass that pid to open it.
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+static constexpr uint32_t kStatusBlockVersion = 1;
+static constexpr uint32_t kStatusEntryCount = 256;
+
+// Overlay state of a source
+enum StatusState {
+	STATUS_UNUSED = 0, // entry belongs to no source
+	STATUS_IDLE = 1,   // not streaming
+	STATUS_OK = 2,     // streaming, nothing shown
+	STATUS_DROPPING = 3,
+	STATUS_DEGRADING = 4,
+	STATUS_RECONNECTING = 5,
+	STATUS_STABLE = 6,
+	STATUS_STATE_COUNT
+};
+
+struct StatusEntry {
+	std::atomic<uint32_t> seq;          // odd while a write is in progress
+	std::atomic<uint32_t> state;        // StatusState
+	std::atomic<uint32_t> cause;        // DropCause while dropping, DROP_CAUSE_NONE otherwise
+	std::atomic<float> drop_pct;        // windowed drop % of that cause (network when none)
+	std::atomic<uint64_t> episode;      // alert episodes the source started; +1 with every new one
+	std::atomic<uint64_t> incident_seq; // incident log record of the current or last episode, 0 = none
+	char name[32];                      // source name, NUL-terminated
+};
+static_assert(sizeof(StatusEntry) == 64, "status entry layout is shared with other programs");
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<float>::is_always_lock_free,
+	      "status entries must be lock-free to work across processes");
+
+struct StatusBlockHeader {
+	char magic[8]; // "OSSTATUS"
+	uint32_t version;
+	uint32_t entry_size;
+	uint32_t entry_count;
+	uint32_t pid;                   // process that publishes the block
+	std::atomic<uint32_t> active;   // 0 while publishing is turned off; entries are stale then
+	std::atomic<uint32_t> overflow; // sources without an entry because every entry is taken
+	uint8_t reserved[32];
+};
+static_assert(sizeof(StatusBlockHeader) == 64, "status block header layout is shared with other programs");
+
+// A mapped block
+struct StatusBlock {
+	StatusBlockHeader *header = nullptr;
+	StatusEntry *entries = nullptr;
+	size_t size = 0;
+	void *map_handle = nullptr; // file mapping (Windows)
+	uint32_t name_pid = 0;      // pid suffix of the name, 0 = the plain name
+};
+
+// Values of one entry
+struct StatusValues {
+	uint32_t state = STATUS_UNUSED;
+	uint32_t cause = 0;
+	float drop_pct = 0.0f;
+	uint64_t episode = 0;
+	uint64_t incident_seq = 0;
+};
+
+// Publisher: create the block, or take over one a crashed process left behind. A block
+// another running process publishes is never touched; the name gets this process's pid then.
+bool status_block_create(StatusBlock *block);
+
+// Reader: map an existing block read-only; pid selects a suffixed name, 0 the plain one
+bool status_block_open_readonly(StatusBlock *block, uint32_t pid);
+
+// Unmap; the publisher also removes the name so readers see it disappear
+void status_block_close(StatusBlock *block, bool remove);
+
+// Store values (and the name, when not nullptr). False when another writer holds the entry;
+// nothing was written then, try again later.
+bool status_entry_write(StatusEntry *entry, const StatusValues *values, const char *name);
+
+// Consistent copy of an entry; false if it kept changing while being read
+bool status_entry_read(const StatusEntry *entry, StatusValues *values, char name[32]);
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "core/text_template.hpp"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *const kVarNames[TEMPLATE_VAR_COUNT] = {"drop_pct", "dropped",    "total", "bitrate",
+							   "lag_pct",  "congestion", "cause"};
+static const char *const kCauseNames[DROP_CAUSE_COUNT] = {"network", "encoder", "rendering"};
+
+static constexpr double kBitrateSmoothingSec = 1.0;
+
+// ------------------------ Compile (UI thread) ------------------------
+static int find_var(const char *name, size_t len)
+{
+	for (int v = 0; v < TEMPLATE_VAR_COUNT; v++)
+		if (strlen(kVarNames[v]) == len && memcmp(kVarNames[v], name, len) == 0)
+			return v;
+	return TEMPLATE_LITERAL;
+}
+
+// Extend the trailing literal token, or start one
+static void append_literal(TextTemplate *tmpl, const char *text, size_t len)
+{
+	if (tmpl->tokens.empty() || tmpl->tokens.back().var != TEMPLATE_LITERAL) {
+		const uint32_t at = (uint32_t)tmpl->literals.size();
+		tmpl->tokens.push_back({TEMPLATE_LITERAL, at, at});
+	}
+	tmpl->literals.append(text, len);
+	tmpl->tokens.back().end = (uint32_t)tmpl->literals.size();
+}
+
+bool text_template_compile(TextTemplate *tmpl, const char *text)
+{
+	*tmpl = TextTemplate{};
+	bool has_vars = false;
+	for (const char *p = text ? text : ""; *p;) {
+		if ((p[0] == '{' && p[1] == '{') || (p[0] == '}' && p[1] == '}')) {
+			append_literal(tmpl, p, 1);
+			p += 2;
+			continue;
+		}
+		if (p[0] == '{') {
+			const char *close = strchr(p + 1, '}');
+			const int var = close ? find_var(p + 1, (size_t)(close - p - 1)) : TEMPLATE_LITERAL;
+			if (var != TEMPLATE_LITERAL) {
+				tmpl->tokens.push_back({var, 0, 0});
+				has_vars = true;
+				p = close + 1;
+				continue;
+			}
+		}
+		append_literal(tmpl, p, 1);
+		p++;
+	}
+	return has_vars;
+}
+
+// ------------------------ Render (graphics thread) ------------------------
+void text_template_render(const TextTemplate *tmpl, const TemplateValues *values, std::string *out)
+{
+	out->clear();
+	char num[32];
+	for (const TemplateToken &tok : tmpl->tokens) {
+		int n = 0;
+		switch (tok.var) {
+		case TEMPLATE_LITERAL:
+			out->append(tmpl->literals, tok.begin, tok.end - tok.begin);
+			continue;
+		case TEMPLATE_VAR_DROP_PCT:
+			n = snprintf(num, sizeof(num), "%.1f", values->drop_pct);
+			break;
+		case TEMPLATE_VAR_DROPPED:
+			n = snprintf(num, sizeof(num), "%llu", (unsigned long long)values->dropped);
+			break;
+		case TEMPLATE_VAR_TOTAL:
+			n = snprintf(num, sizeof(num), "%llu", (unsigned long long)values->total);
+			break;
+		case TEMPLATE_VAR_BITRATE:
+			n = snprintf(num, sizeof(num), "%.0f", values->bitrate_kbps);
+			break;
+		case TEMPLATE_VAR_LAG_PCT:
+			n = snprintf(num, sizeof(num), "%.1f", values->lag_pct);
+			break;
+		case TEMPLATE_VAR_CONGESTION:
+			n = snprintf(num, sizeof(num), "%.0f", values->congestion_pct);
+			break;
+		case TEMPLATE_VAR_CAUSE:
+			if (values->cause >= 0 && values->cause < DROP_CAUSE_COUNT)
+				out->append(kCauseNames[values->cause]);
+			continue;
+		default:
+			continue;
+		}
+		if (n > 0)
+			out->append(num, (size_t)n < sizeof(num) ? (size_t)n : sizeof(num) - 1);
+	}
+}
+
+void template_meter_push(TemplateMeter *meter, const DropSample *sample)
+{
+	if (!sample->fresh)
+		return;
+	if (!sample->active) {
+		*meter = TemplateMeter{};
+		return;
+	}
+	meter->network = sample->counters[DROP_CAUSE_NETWORK];
+	meter->congestion_pct = sample->congestion * 100.0;
+
+	// Counters that went backwards were restarted; measure from here
+	if (meter->have_last && sample->total_bytes >= meter->last_bytes && sample->timestamp_ns > meter->last_ns) {
+		const double dt = (double)(sample->timestamp_ns - meter->last_ns) / 1e9;
+		const double kbps = (double)(sample->total_bytes - meter->last_bytes) * 8.0 / 1000.0 / dt;
+		const double a = 1.0 - exp(-dt / kBitrateSmoothingSec);
+		meter->kbps = meter->kbps > 0.0 ? meter->kbps + a * (kbps - meter->kbps) : kbps;
+	}
+	meter->last_bytes = sample->total_bytes;
+	meter->last_ns = sample->timestamp_ns;
+	meter->have_last = true;
+}
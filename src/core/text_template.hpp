@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+// Overlay text with live values, e.g. "Dropping {drop_pct}% ({dropped} frames, {bitrate} kbps)".
+// update() compiles the text once into a token list; the graphics thread renders it into a
+// reused buffer, so formatting does not allocate once the buffer has grown. "{{" and "}}"
+// stand for literal braces; unknown names are kept as written. Free of libobs.
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "core/drop_detector.hpp"
+
+enum TemplateVar {
+	TEMPLATE_VAR_DROP_PCT = 0,   // {drop_pct}: windowed drop % of the shown cause, 1 decimal
+	TEMPLATE_VAR_DROPPED = 1,    // {dropped}: frames the watched output(s) dropped this stream
+	TEMPLATE_VAR_TOTAL = 2,      // {total}: frames the watched output(s) sent this stream
+	TEMPLATE_VAR_BITRATE = 3,    // {bitrate}: kbps, smoothed over about a second
+	TEMPLATE_VAR_LAG_PCT = 4,    // {lag_pct}: windowed rendering lag %, 1 decimal
+	TEMPLATE_VAR_CONGESTION = 5, // {congestion}: output congestion %, whole number
+	TEMPLATE_VAR_CAUSE = 6,      // {cause}: "network", "encoder" or "rendering"
+	TEMPLATE_VAR_COUNT,
+	TEMPLATE_LITERAL = -1
+};
+
+struct TemplateToken {
+	int var = TEMPLATE_LITERAL; // TemplateVar, or a literal run
+	uint32_t begin = 0;         // literal: range in TextTemplate::literals
+	uint32_t end = 0;
+};
+
+struct TextTemplate {
+	std::string literals; // literal runs, unescaped, back to back
+	std::vector<TemplateToken> tokens;
+};
+
+// Values a template can show, gathered once per refresh
+struct TemplateValues {
+	double drop_pct = 0.0;
+	uint64_t dropped = 0;
+	uint64_t total = 0;
+	double bitrate_kbps = 0.0;
+	double lag_pct = 0.0;
+	double congestion_pct = 0.0;
+	int cause = DROP_CAUSE_NETWORK;
+};
+
+// Follows fresh samples for the values the detector does not keep
+struct TemplateMeter {
+	bool have_last = false;
+	uint64_t last_ns = 0;
+	uint64_t last_bytes = 0;
+	double kbps = 0.0;
+	FrameCounters network; // counters of the last active sample
+	double congestion_pct = 0.0;
+};
+
+// Compile text; false when it has no variables (then it never needs re-rendering)
+bool text_template_compile(TextTemplate *tmpl, const char *text);
+
+// Render into out, reusing its storage
+void text_template_render(const TextTemplate *tmpl, const TemplateValues *values, std::string *out);
+
+// Call every tick with the detector's sample; only fresh ones count
+void template_meter_push(TemplateMeter *meter, const DropSample *sample);
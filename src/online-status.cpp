@@ -1,8 +1,14 @@
 // Order includes so OBS types are visible before we declare callbacks
 #include "online_status.hpp"
+#include "online_status_loader.hpp"
+#include "online_status_sampler.hpp"
+#include <graphics/vec4.h>
+#include <util/platform.h>
+#include <sys/stat.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <algorithm>
 #include <string>
-#include <obs-frontend-api.h>
-#include <cmath>
 #include <utility>
 
 /*
@@ -12,38 +18,135 @@
 // OnlineStatus is declared in online_status.hpp
 
 // ------------------------ Readability helpers ------------------------
-static inline bool dropping_blink_ok(const OnlineStatus *s)
+// Graphics thread; s->cfg is the snapshot picked up by the current tick
+static inline bool should_show_dropping(const OnlineStatus *s)
 {
-	return !s->drop_blink_enabled || s->drop_blink_on;
+	return s->det.auto_visible || s->cfg->visible;
 }
 
-static inline bool stable_blink_ok(const OnlineStatus *s)
+static inline bool should_show_stable(const OnlineStatus *s)
 {
-	return !s->stable_blink_enabled || s->stable_blink_on;
+	return s->det.stable_visible && s->cfg->detect.stable_enabled;
 }
 
-static inline bool should_show_dropping(const OnlineStatus *s)
+// Slot that shows a cause; causes without their own content use the dropping slot
+static inline int slot_for_cause(const OnlineStatus *s, int cause)
 {
-	return (s->auto_visible || s->visible) && dropping_blink_ok(s);
+	int slot = SLOT_DROPPING;
+	if (cause == DROP_CAUSE_ENCODER)
+		slot = SLOT_ENCODER;
+	else if (cause == DROP_CAUSE_RENDER)
+		slot = SLOT_RENDER;
+	if (s->cfg->slots[slot].mode == CONTENT_SAME_AS_DROPPING)
+		slot = SLOT_DROPPING;
+	return slot;
 }
 
-static inline bool should_show_stable(const OnlineStatus *s)
+// Slot currently on screen, or -1 when nothing is shown
+static inline int visible_slot(const OnlineStatus *s)
+{
+	if (drop_detector_reconnecting_on(&s->det, &s->cfg->detect))
+		return SLOT_RECONNECTING;
+	if (should_show_dropping(s))
+		return slot_for_cause(s, s->det.cause);
+	if (s->det.degrading_visible)
+		return SLOT_DEGRADING;
+	if (should_show_stable(s))
+		return SLOT_STABLE;
+	return -1;
+}
+
+static inline obs_source_t *slot_child(const SlotConfig *slot)
 {
-	return s->stable_visible && s->stable_enabled && stable_blink_ok(s);
+	if (slot->mode == CONTENT_IMAGE && slot->image_child)
+		return slot->image_child;
+	return slot->text_child;
 }
 
+// Only touches the children when the shown slot changes; a new snapshot forces a resync
 static inline void sync_child_enabled(OnlineStatus *s)
 {
-	const bool show_drop = should_show_dropping(s);
-	const bool show_stable = should_show_stable(s);
-	if (s->status_text.get())
-		obs_source_set_enabled(s->status_text.get(), show_drop && s->content_mode == 0);
-	if (s->status_image.get())
-		obs_source_set_enabled(s->status_image.get(), show_drop && s->content_mode == 1);
-	if (s->status_text_stable.get())
-		obs_source_set_enabled(s->status_text_stable.get(), show_stable && s->stable_mode == 0);
-	if (s->status_image_stable.get())
-		obs_source_set_enabled(s->status_image_stable.get(), show_stable && s->stable_mode == 1);
+	const int shown = visible_slot(s);
+	if (shown == s->shown_slot)
+		return;
+	s->shown_slot = shown;
+	for (int i = 0; i < SLOT_COUNT; i++) {
+		const SlotConfig &slot = s->cfg->slots[i];
+		const bool on = (i == shown);
+		if (slot.text_child)
+			obs_source_set_enabled(slot.text_child, on && slot.mode == CONTENT_TEXT);
+		if (slot.image_child)
+			obs_source_set_enabled(slot.image_child, on && slot.mode == CONTENT_IMAGE);
+	}
+}
+
+// Animation of a slot; causes animate like the dropping overlay they stand in for
+static inline AnimSettings slot_anim(const OnlineStatus *s, int slot)
+{
+	if (slot == SLOT_DROPPING || slot == SLOT_ENCODER || slot == SLOT_RENDER)
+		return s->cfg->drop_anim;
+	if (slot == SLOT_STABLE)
+		return s->cfg->stable_anim;
+	return AnimSettings{};
+}
+
+// Rebuild the render plan from the shown slot (call after sync_child_enabled)
+static void build_render_plan(OnlineStatus *s)
+{
+	const int shown = s->shown_slot;
+	const SlotConfig &slot = s->cfg->slots[shown >= 0 ? shown : SLOT_DROPPING];
+	RenderPlan &plan = s->plan;
+	plan.visible = shown >= 0;
+	plan.graph = slot.mode == CONTENT_GRAPH;
+	if (plan.graph) {
+		plan.image = nullptr;
+		plan.child = nullptr;
+		plan.cx = kGraphWidth;
+		plan.cy = kGraphHeight;
+		plan.cacheable = false;
+		plan.anim = AnimSettings{}; // drawn as lines, not from a texture
+		return;
+	}
+	plan.sprite = slot.mode == CONTENT_SPRITE;
+	plan.image = (slot.mode == CONTENT_IMAGE || plan.sprite) ? slot.image : nullptr;
+	plan.child = plan.image ? nullptr : slot_child(&slot);
+	plan.cx = plan.child ? obs_source_get_width(plan.child) : 0;
+	plan.cy = plan.child ? obs_source_get_height(plan.child) : 0;
+	plan.cacheable = !(slot.mode == CONTENT_IMAGE && slot.animated);
+	plan.anim = slot_anim(s, shown);
+}
+
+// Plays a cue once when the dropping or stable overlay appears (call after sync_child_enabled).
+// Switching between causes keeps the cue, and a cue never starts over one still playing.
+// source is the OBS source that outputs it: the owner, or the driver of a linked group. Only
+// sources of the sound id have an audio mixer entry to output it on.
+static void update_audio_cue(OnlineStatus *s, obs_source_t *source)
+{
+	if (!source || !(obs_source_get_output_flags(source) & OBS_SOURCE_AUDIO))
+		return;
+	const int shown = s->shown_slot;
+	int cue = AUDIO_CUE_NONE;
+	if (shown == SLOT_DROPPING || shown == SLOT_ENCODER || shown == SLOT_RENDER)
+		cue = AUDIO_CUE_DROPPING;
+	else if (shown == SLOT_STABLE)
+		cue = AUDIO_CUE_STABLE;
+	if (cue == s->audio_cue)
+		return;
+	s->audio_cue = cue;
+	if (cue == AUDIO_CUE_NONE || !s->cfg->sound[cue] || os_gettime_ns() < s->audio_until_ns)
+		return;
+	s->audio_until_ns = online_status_audio_play(source, cue);
+}
+
+// Shared images finish decoding on their own, so ask the cache for their size
+static inline void publish_plan_size(OnlineStatus *s)
+{
+	uint32_t cx = s->plan.cx;
+	uint32_t cy = s->plan.cy;
+	if (s->plan.image)
+		online_status_image_size(s->plan.image, &cx, &cy);
+	s->width.store(cx, std::memory_order_relaxed);
+	s->height.store(cy, std::memory_order_relaxed);
 }
 
 // release_source helper no longer needed with smart pointers
@@ -57,14 +160,19 @@ static obs_source_t *create_text_child_raw(const char *name, const char *text_va
 #else
 	const char *candidates[] = {"text_ft2_source_v2", "text_gdiplus"};
 #endif
+	// Backend that worked last time; saves probing for every child (UI thread only)
+	static const char *s_text_id = nullptr;
 
 	obs_source_t *result = nullptr;
 	for (const char *id : candidates) {
+		if (s_text_id && id != s_text_id)
+			continue;
 		obs_data_t *child = obs_data_create();
 		obs_data_set_string(child, "text", text_value ? text_value : "");
 		result = obs_source_create_private(id, name, child);
 		obs_data_release(child);
 		if (result) {
+			s_text_id = id;
 			return result; // Success on first working backend
 		}
 	}
@@ -85,10 +193,11 @@ static obs_source_t *create_image_child_raw(const char *name, const char *file_p
 }
 
 // ------------------------ Child update helpers ------------------------
-static inline void update_text_child(obs_source_t *child, const std::string &text)
+static inline void update_text_child(TraceTrack *trace, obs_source_t *child, const std::string &text)
 {
 	if (!child)
 		return;
+	TraceScope scope(trace, TRACE_CHILD_UPDATE);
 	obs_data_t *data = obs_data_create();
 	obs_data_set_string(data, "text", text.c_str());
 	obs_source_update(child, data);
@@ -105,211 +214,751 @@ static inline void update_image_child(obs_source_t *child, const std::string &fi
 	obs_data_release(data);
 }
 
+// 0 when the file cannot be read
+static time_t file_mtime(const std::string &path)
+{
+	struct stat st;
+	return os_stat(path.c_str(), &st) == 0 ? st.st_mtime : 0;
+}
+
+// GIFs animate inside the image source, so a cached texture would freeze them
+static inline bool is_animated_image(const std::string &path)
+{
+	const size_t n = path.size();
+	return n >= 4 && path[n - 4] == '.' && tolower((unsigned char)path[n - 3]) == 'g' &&
+	       tolower((unsigned char)path[n - 2]) == 'i' && tolower((unsigned char)path[n - 1]) == 'f';
+}
+
+// ------------------------ Slot settings ------------------------
+struct SlotKeys {
+	const char *mode;
+	const char *text;
+	const char *image;
+	const char *text_child;
+	const char *image_child;
+};
+
+static const SlotKeys kSlotKeys[SLOT_COUNT] = {
+	{"content_mode", "status_text", "image_path", "online-status:text", "online-status:image"},
+	{"encoder_mode", "encoder_text", "encoder_image_path", "online-status:text-encoder",
+	 "online-status:image-encoder"},
+	{"render_mode", "render_text", "render_image_path", "online-status:text-render", "online-status:image-render"},
+	{"degrade_mode", "degrade_text", "degrade_image_path", "online-status:text-degrade",
+	 "online-status:image-degrade"},
+	{"reconnect_mode", "reconnect_text", "reconnect_image_path", "online-status:text-reconnect",
+	 "online-status:image-reconnect"},
+	{"stable_mode", "stable_text", "stable_image_path", "online-status:text-stable", "online-status:image-stable"},
+};
+
+// ------------------------ Config snapshots ------------------------
+static void config_free(OnlineStatusConfig *cfg)
+{
+	for (SlotConfig &slot : cfg->slots) {
+		if (slot.text_child)
+			obs_source_release(slot.text_child);
+		if (slot.image_child)
+			obs_source_release(slot.image_child);
+		online_status_image_release(slot.image);
+	}
+	delete cfg;
+}
+
+// Take the slot content and references from the writer side (config_mutex held)
+static void config_fill_slots(OnlineStatusConfig *cfg, const OnlineStatus *s)
+{
+	for (int i = 0; i < SLOT_COUNT; i++) {
+		const OverlaySlot &src = s->slots[i];
+		SlotConfig &dst = cfg->slots[i];
+		dst.mode = src.mode;
+		dst.text = src.text;
+		dst.text_template = src.text_template;
+		dst.animated = src.animated;
+		dst.text_child = src.text_child ? obs_source_get_ref(src.text_child.get()) : nullptr;
+		dst.image_child = src.image_child ? obs_source_get_ref(src.image_child.get()) : nullptr;
+		dst.image = online_status_image_ref(src.image);
+	}
+}
+
+// Take out replaced snapshots older than the one the graphics thread holds. It only ever
+// holds the newest snapshot it loaded, so anything older can no longer be read. The caller
+// frees them once config_mutex is released: releasing children or the last reference to a
+// linked group (whose engine then goes away) must not happen under the lock.
+static void reclaim_configs(OnlineStatus *s, std::vector<OnlineStatusConfig *> *freed)
+{
+	const uint64_t seen = s->config_seen.load(std::memory_order_acquire);
+	size_t kept = 0;
+	for (OnlineStatusConfig *cfg : s->retired) {
+		if (cfg->gen < seen)
+			freed->push_back(cfg);
+		else
+			s->retired[kept++] = cfg;
+	}
+	s->retired.resize(kept);
+}
+
+// Publish a snapshot whose values are set; the slots are filled here (config_mutex held).
+// Snapshots that can go are added to freed, see reclaim_configs.
+static void publish_config(OnlineStatus *s, OnlineStatusConfig *next, std::vector<OnlineStatusConfig *> *freed)
+{
+	config_fill_slots(next, s);
+	next->gen = ++s->config_gen;
+	OnlineStatusConfig *prev = s->config.exchange(next, std::memory_order_acq_rel);
+	if (prev)
+		s->retired.push_back(prev);
+	reclaim_configs(s, freed);
+}
+
+// ------------------------ Image loads ------------------------
+// Loader thread, pending->mutex held: swap in the new child unless the slot moved on
+static void adopt_image_child(OnlineStatus *s, const PendingChild *pending, obs_source_t *source)
+{
+	std::vector<OnlineStatusConfig *> freed;
+	{
+		std::lock_guard<std::mutex> lock(s->config_mutex);
+		for (OverlaySlot &slot : s->slots) {
+			if (slot.pending_image.get() != pending)
+				continue;
+			slot.pending_image.reset();
+			slot.image_child.reset(source);
+			publish_config(s, new OnlineStatusConfig(*s->config.load(std::memory_order_relaxed)),
+				       &freed);
+			source = nullptr;
+			break;
+		}
+	}
+	for (OnlineStatusConfig *cfg : freed)
+		config_free(cfg);
+	if (source)
+		obs_source_release(source);
+}
+
+// Stop a load from reaching its owner; waits for a load that is being adopted right now.
+// Never call with config_mutex held, adopting takes it under pending->mutex.
+static void cancel_pending_image(const std::shared_ptr<PendingChild> &pending)
+{
+	std::lock_guard<std::mutex> lock(pending->mutex);
+	pending->cancelled = true;
+}
+
+// Decode the image on the loader thread; the current child (if any) stays up until then
+static void request_image_child(OnlineStatus *s, OverlaySlot *slot, const char *name)
+{
+	auto pending = std::make_shared<PendingChild>();
+	pending->owner = s;
+	slot->pending_image = pending;
+
+	online_status_loader_submit([pending, name = std::string(name), path = slot->image_path] {
+		obs_source_t *source = create_image_child_raw(name.c_str(), path.c_str());
+		std::lock_guard<std::mutex> lock(pending->mutex);
+		if (pending->cancelled) {
+			if (source)
+				obs_source_release(source);
+			return;
+		}
+		adopt_image_child(pending->owner, pending.get(), source);
+	});
+}
+
+// Read a slot's settings; only the child for the selected mode is kept (config_mutex held).
+// Released children stay alive in the snapshots that still name them. Loads that are no
+// longer wanted go to `dropped`, to be cancelled once config_mutex is released.
+static void update_slot(OnlineStatus *s, OverlaySlot *slot, const SlotKeys &keys, obs_data_t *settings,
+			bool can_share, bool in_use, std::vector<std::shared_ptr<PendingChild>> *dropped)
+{
+	slot->mode = (int)obs_data_get_int(settings, keys.mode);
+	if (slot->mode == CONTENT_SAME_AS_DROPPING && !can_share)
+		slot->mode = CONTENT_TEXT;
+	const char *txt = obs_data_get_string(settings, keys.text);
+	const bool text_changed = slot->text != (txt ? txt : "");
+	if (text_changed) {
+		slot->text = txt ? txt : "";
+		// The reconnecting text has its own elapsed-time suffix instead
+		auto tmpl = std::make_shared<TextTemplate>();
+		const bool live = slot != &s->slots[SLOT_RECONNECTING] && text_template_compile(tmpl.get(), txt);
+		slot->text_template = live ? std::move(tmpl) : nullptr;
+	}
+	const char *img = obs_data_get_string(settings, keys.image);
+	bool image_changed = slot->image_path != (img ? img : "");
+	slot->image_path = img ? img : "";
+	slot->animated = is_animated_image(slot->image_path);
+
+	const bool want_text = in_use && slot->mode == CONTENT_TEXT;
+	const bool want_image = in_use && slot->mode == CONTENT_IMAGE;
+	const bool want_sprite = in_use && slot->mode == CONTENT_SPRITE;
+	// Static images come from the shared cache; animated ones need their own image_source.
+	// Sprites come from the cache too, as one texture holding every frame.
+	const bool want_image_child = want_image && slot->animated;
+	const bool want_cached_image = (want_image && !slot->animated) || want_sprite;
+	const uint32_t cols = want_sprite ? (uint32_t)obs_data_get_int(settings, "sprite_columns") : 0;
+	const uint32_t rows = want_sprite ? (uint32_t)obs_data_get_int(settings, "sprite_rows") : 0;
+	const bool grid_changed = cols != slot->sprite_cols || rows != slot->sprite_rows;
+	// Animated images live in their own image source; reload it only when the file was
+	// replaced on disk (the shared cache watches static images itself)
+	if (want_image_child) {
+		const time_t mtime = file_mtime(slot->image_path);
+		image_changed = image_changed || mtime != slot->image_mtime;
+		slot->image_mtime = mtime;
+	}
+
+	// Release what the selected mode does not show
+	if (!want_text)
+		slot->text_child.reset();
+	if (slot->pending_image && (!want_image_child || image_changed))
+		dropped->push_back(std::move(slot->pending_image));
+	if (!want_image_child)
+		slot->image_child.reset();
+	if (!want_cached_image || image_changed || grid_changed) {
+		online_status_image_release(slot->image);
+		slot->image = nullptr;
+	}
+
+	if (want_text) {
+		// Templates start out with empty values; the graphics thread fills them in
+		std::string initial = slot->text;
+		if (slot->text_template) {
+			const TemplateValues empty;
+			text_template_render(slot->text_template.get(), &empty, &initial);
+		}
+		// Untouched texts keep their child as it is, including live values it shows
+		if (!slot->text_child)
+			slot->text_child.reset(create_text_child_raw(keys.text_child, initial.c_str()));
+		else if (text_changed)
+			update_text_child(s->trace, slot->text_child.get(), initial);
+	}
+	if (want_image_child && (image_changed || (!slot->image_child && !slot->pending_image)))
+		request_image_child(s, slot, keys.image_child);
+	if (want_cached_image && !slot->image) {
+		slot->image = want_sprite ? online_status_sprite_acquire(slot->image_path.c_str(), cols, rows)
+					  : online_status_image_acquire(slot->image_path.c_str());
+		slot->sprite_cols = cols;
+		slot->sprite_rows = rows;
+	}
+}
+
+// Append the time spent reconnecting; the text child is only updated once per second
+static void update_reconnect_text(OnlineStatus *s)
+{
+	const SlotConfig &slot = s->cfg->slots[SLOT_RECONNECTING];
+	if (slot.mode != CONTENT_TEXT || !slot.text_child)
+		return;
+	if (!s->cfg->reconnect_show_elapsed) {
+		// Turned off while the child still shows a time (update() left the text alone)
+		if (s->reconnect_suffixed) {
+			update_text_child(s->trace, slot.text_child, slot.text);
+			s->reconnect_suffixed = false;
+			s->content_gen++;
+		}
+		return;
+	}
+	const int secs = (int)s->det.reconnect_sec;
+	if (secs == s->reconnect_shown_sec)
+		return;
+	s->reconnect_shown_sec = secs;
+	char elapsed[32];
+	snprintf(elapsed, sizeof(elapsed), " %d:%02d", secs / 60, secs % 60);
+	update_text_child(s->trace, slot.text_child, slot.text + elapsed);
+	s->reconnect_suffixed = true;
+	s->content_gen++;
+}
+
+// Values for templates: the detector's windowed percentages plus what the meter follows
+static void fill_template_values(const OnlineStatus *s, TemplateValues *v)
+{
+	const int cause = s->det.cause < DROP_CAUSE_COUNT ? s->det.cause : DROP_CAUSE_NETWORK;
+	v->cause = cause;
+	v->drop_pct = s->det.signals[cause].pct;
+	v->lag_pct = s->det.signals[DROP_CAUSE_RENDER].pct;
+	v->dropped = s->template_meter.network.dropped;
+	v->total = s->template_meter.network.total;
+	v->bitrate_kbps = s->template_meter.kbps;
+	v->congestion_pct = s->template_meter.congestion_pct;
+}
+
+// Re-render the shown slot's template when it appears and then at most once per refresh
+// period. The text child only gets the result when the string changed, so steady values
+// never make it lay out the text again.
+static void refresh_template_text(OnlineStatus *s, float seconds)
+{
+	const int shown = s->shown_slot;
+	const SlotConfig *slot = shown >= 0 ? &s->cfg->slots[shown] : nullptr;
+	if (!slot || slot->mode != CONTENT_TEXT || !slot->text_template || !slot->text_child) {
+		s->template_slot = -1;
+		return;
+	}
+	if (shown == s->template_slot) {
+		s->template_timer -= seconds;
+		if (s->template_timer > 0.0f)
+			return;
+	}
+	s->template_slot = shown;
+	s->template_timer = s->cfg->text_refresh_sec;
+
+	TemplateValues values;
+	fill_template_values(s, &values);
+	text_template_render(slot->text_template.get(), &values, &s->template_buf);
+	if (s->template_buf == s->template_text[shown])
+		return;
+	s->template_text[shown].swap(s->template_buf);
+	update_text_child(s->trace, slot->text_child, s->template_text[shown]);
+	s->content_gen++;
+}
+
+// Output label of each OutputPolicy in the incident log
+static const char *const kPolicyLabels[OUTPUT_POLICY_COUNT] = {"streaming", "all:worst", "all:weighted", "all:any"};
+
+// Switch watched outputs; only all-output policies keep the sampler enumerating.
+// The detector rebases on the graphics thread once it sees the new policy.
+static int set_output_policy(OnlineStatus *s, int policy)
+{
+	if (policy < OUTPUT_POLICY_STREAMING || policy >= OUTPUT_POLICY_COUNT)
+		policy = OUTPUT_POLICY_STREAMING;
+	const bool was_all = s->output_policy != OUTPUT_POLICY_STREAMING;
+	const bool is_all = policy != OUTPUT_POLICY_STREAMING;
+	if (was_all != is_all)
+		online_status_sampler_track_all_outputs(is_all);
+	s->output_policy = policy;
+	return policy;
+}
+
+// Scenes saved before animations only have the blink toggle; it maps to the Blink preset
+static void read_anim(AnimSettings *anim, obs_data_t *settings, const char *kind_key, const char *easing_key,
+		      const char *rate_key, const char *legacy_blink_key)
+{
+	anim->kind = (int)obs_data_get_int(settings, kind_key);
+	if (!obs_data_has_user_value(settings, kind_key) && obs_data_get_bool(settings, legacy_blink_key))
+		anim->kind = ANIM_BLINK;
+	anim->easing = (int)obs_data_get_int(settings, easing_key);
+	anim->rate_hz = (float)obs_data_get_double(settings, rate_key);
+	if (anim->rate_hz < 0.0f)
+		anim->rate_hz = 0.0f;
+}
+
 const char *online_status_get_name(void *)
 {
 	return "Online Status";
 }
 
+const char *online_status_sound_get_name(void *)
+{
+	return "Online Status (with sound cues)";
+}
+
 void online_status_defaults(obs_data_t *settings)
 {
 	obs_data_set_default_string(settings, "status_text", "");
 	obs_data_set_default_string(settings, "image_path", "");
 	obs_data_set_default_int(settings, "content_mode", 0);
-	// UI section (pseudo-tabs): 0=Dropping,1=Stable,2=Blink,3=Advanced
-	obs_data_set_default_int(settings, "ui_section", 0);
+	// UI section (pseudo-tabs): 0=Dropping,1=Stable,2=Advanced,3=Causes,4=Early warning,5=Reconnecting
+	obs_data_set_default_int(settings, "ui_section", SECTION_DROPPING);
 	// Stable overlay defaults
 	obs_data_set_default_bool(settings, "stable_enabled", true);
 	obs_data_set_default_int(settings, "stable_mode", 0);
 	obs_data_set_default_string(settings, "stable_text", "Connection is stable again");
 	obs_data_set_default_string(settings, "stable_image_path", "");
+	// Causes: network drops are watched by default, encoder/render lag are opt-in
+	obs_data_set_default_bool(settings, "watch_network", true);
+	obs_data_set_default_bool(settings, "watch_encoder", false);
+	obs_data_set_default_bool(settings, "watch_render", false);
+	obs_data_set_default_int(settings, "encoder_mode", CONTENT_SAME_AS_DROPPING);
+	obs_data_set_default_string(settings, "encoder_text", "Stream is stuttering (encoder overloaded)");
+	obs_data_set_default_string(settings, "encoder_image_path", "");
+	obs_data_set_default_int(settings, "render_mode", CONTENT_SAME_AS_DROPPING);
+	obs_data_set_default_string(settings, "render_text", "Stream is stuttering (rendering lag)");
+	obs_data_set_default_string(settings, "render_image_path", "");
+	// Early warning (congestion / bitrate trend)
+	obs_data_set_default_bool(settings, "degrade_enabled", false);
+	obs_data_set_default_double(settings, "degrade_congestion_pct", 50.0);
+	obs_data_set_default_double(settings, "degrade_slope_pct", 20.0);
+	obs_data_set_default_double(settings, "degrade_bitrate_drop_pct", 30.0);
+	obs_data_set_default_int(settings, "degrade_mode", CONTENT_TEXT);
+	obs_data_set_default_string(settings, "degrade_text", "Connection is getting unstable");
+	obs_data_set_default_string(settings, "degrade_image_path", "");
+	// Reconnecting (streaming output signals)
+	obs_data_set_default_bool(settings, "reconnect_enabled", true);
+	obs_data_set_default_int(settings, "reconnect_mode", CONTENT_TEXT);
+	obs_data_set_default_string(settings, "reconnect_text", "Reconnecting...");
+	obs_data_set_default_bool(settings, "reconnect_show_elapsed", true);
+	obs_data_set_default_string(settings, "reconnect_image_path", "");
 	obs_data_set_default_double(settings, "stable_duration_sec", 3.0);
 	obs_data_set_default_double(settings, "drop_threshold_pct", 1.0);
+	obs_data_set_default_double(settings, "drop_exit_threshold_pct", 0.5);
+	obs_data_set_default_int(settings, "drop_window_ms", 1000);
+	obs_data_set_default_int(settings, "drop_threshold_mode", THRESHOLD_FIXED);
+	obs_data_set_default_double(settings, "adaptive_quantile", 99.0);
+	obs_data_set_default_int(settings, "adaptive_learn_sec", 120);
+	obs_data_set_default_double(settings, "adaptive_min_pct", 0.05);
 	obs_data_set_default_double(settings, "hide_after_sec", 3.0);
 	obs_data_set_default_bool(settings, "visible", false);
 	// Advanced test defaults
 	obs_data_set_default_bool(settings, "test_force_drop", false);
-	// Blink defaults (separate)
-	obs_data_set_default_bool(settings, "drop_blink_enabled", false);
+	// Animations; the *_blink_rate_hz keys are kept as the speed of every animation
+	obs_data_set_default_int(settings, "drop_anim", ANIM_NONE);
+	obs_data_set_default_int(settings, "drop_anim_easing", EASING_SMOOTH);
 	obs_data_set_default_double(settings, "drop_blink_rate_hz", 1.0);
-	obs_data_set_default_bool(settings, "stable_blink_enabled", false);
+	obs_data_set_default_int(settings, "stable_anim", ANIM_NONE);
+	obs_data_set_default_int(settings, "stable_anim_easing", EASING_SMOOTH);
 	obs_data_set_default_double(settings, "stable_blink_rate_hz", 1.0);
+	// Audio cues
+	obs_data_set_default_bool(settings, "drop_sound", false);
+	obs_data_set_default_bool(settings, "stable_sound", false);
+	// Graph content mode
+	obs_data_set_default_int(settings, "graph_seconds", 30);
+	// Live text templates
+	obs_data_set_default_int(settings, "text_refresh_ms", 500);
+	// Sprite content mode
+	obs_data_set_default_int(settings, "sprite_columns", 1);
+	obs_data_set_default_int(settings, "sprite_rows", 1);
+	obs_data_set_default_int(settings, "sprite_frames", 0);
+	obs_data_set_default_double(settings, "sprite_fps", 12.0);
+	obs_data_set_default_bool(settings, "sprite_gif_timing", true);
+	// Render the shown overlay through a texture cache
+	obs_data_set_default_bool(settings, "render_cache", false);
+	// Shared stats sampler interval and watched outputs
+	obs_data_set_default_int(settings, "stats_interval_ms", 100);
+	obs_data_set_default_int(settings, "output_policy", OUTPUT_POLICY_STREAMING);
+	// Metrics exporter (module-wide)
+	obs_data_set_default_int(settings, "metrics_export", METRICS_EXPORT_OFF);
+	obs_data_set_default_string(settings, "metrics_path", "");
+	// Shared memory status block (module-wide)
+	obs_data_set_default_bool(settings, "status_shm", false);
+	// Linked group (none)
+	obs_data_set_default_string(settings, "link_group", "");
+	// Tracer (module-wide)
+	obs_data_set_default_bool(settings, "trace_enabled", false);
+	// Sample recorder (module-wide)
+	obs_data_set_default_bool(settings, "record_samples", false);
 }
 
-void online_status_update(void *data, obs_data_t *settings)
+// Read settings into a new snapshot. Members of a linked group keep no content of their own;
+// their snapshot only carries the group.
+static void apply_settings(OnlineStatus *s, obs_data_t *settings, const std::shared_ptr<LinkGroup> &link)
 {
-	auto *s = static_cast<OnlineStatus *>(data);
-	s->visible = obs_data_get_bool(settings, "visible");
-	s->content_mode = (int)obs_data_get_int(settings, "content_mode");
-	s->drop_threshold_pct = obs_data_get_double(settings, "drop_threshold_pct");
-	s->hide_after_sec = (float)obs_data_get_double(settings, "hide_after_sec");
+	auto *next = new OnlineStatusConfig();
+	next->link = link;
+	DropDetectorConfig &detect = next->detect;
+	next->visible = obs_data_get_bool(settings, "visible");
+	detect.drop_threshold_pct = obs_data_get_double(settings, "drop_threshold_pct");
+	// Exit threshold above the enter threshold would make the overlay flicker
+	detect.drop_exit_threshold_pct = obs_data_get_double(settings, "drop_exit_threshold_pct");
+	if (detect.drop_exit_threshold_pct > detect.drop_threshold_pct)
+		detect.drop_exit_threshold_pct = detect.drop_threshold_pct;
+	long long window_ms = obs_data_get_int(settings, "drop_window_ms");
+	detect.drop_window_ms = (uint32_t)(window_ms < 250 ? 250 : (window_ms > 10000 ? 10000 : window_ms));
+	detect.adaptive = obs_data_get_int(settings, "drop_threshold_mode") == THRESHOLD_ADAPTIVE;
+	detect.baseline.quantile = obs_data_get_double(settings, "adaptive_quantile");
+	detect.baseline.learn_sec = (float)obs_data_get_int(settings, "adaptive_learn_sec");
+	detect.baseline.min_pct = obs_data_get_double(settings, "adaptive_min_pct");
+	detect.hide_after_sec = (float)obs_data_get_double(settings, "hide_after_sec");
 	// Advanced test flag
-	s->test_force_drop = obs_data_get_bool(settings, "test_force_drop");
-	// Blink settings (separate)
-	s->drop_blink_enabled = obs_data_get_bool(settings, "drop_blink_enabled");
-	s->drop_blink_rate_hz = obs_data_get_double(settings, "drop_blink_rate_hz");
-	if (s->drop_blink_rate_hz < 0.0)
-		s->drop_blink_rate_hz = 0.0;
-	s->stable_blink_enabled = obs_data_get_bool(settings, "stable_blink_enabled");
-	s->stable_blink_rate_hz = obs_data_get_double(settings, "stable_blink_rate_hz");
-	if (s->stable_blink_rate_hz < 0.0)
-		s->stable_blink_rate_hz = 0.0;
-
-	const char *txt = obs_data_get_string(settings, "status_text");
-	s->text = txt ? txt : "";
-	const char *img = obs_data_get_string(settings, "image_path");
-	s->image_path = img ? img : "";
+	detect.force_drop = obs_data_get_bool(settings, "test_force_drop");
+	// Animations (separate for dropping and stable)
+	read_anim(&next->drop_anim, settings, "drop_anim", "drop_anim_easing", "drop_blink_rate_hz",
+		  "drop_blink_enabled");
+	read_anim(&next->stable_anim, settings, "stable_anim", "stable_anim_easing", "stable_blink_rate_hz",
+		  "stable_blink_enabled");
+	next->sound[AUDIO_CUE_DROPPING] = obs_data_get_bool(settings, "drop_sound");
+	next->sound[AUDIO_CUE_STABLE] = obs_data_get_bool(settings, "stable_sound");
+	next->graph_span_sec = (float)obs_data_get_int(settings, "graph_seconds");
+	next->text_refresh_sec = (float)obs_data_get_int(settings, "text_refresh_ms") / 1000.0f;
+	next->sprite_frames = (uint32_t)obs_data_get_int(settings, "sprite_frames");
+	next->sprite_fps = (float)obs_data_get_double(settings, "sprite_fps");
+	if (next->sprite_fps < 0.0f)
+		next->sprite_fps = 0.0f;
+	next->sprite_gif_timing = obs_data_get_bool(settings, "sprite_gif_timing");
+	// Sampler interval is module-wide; the last edited source wins
+	online_status_sampler_set_interval_ms((uint32_t)obs_data_get_int(settings, "stats_interval_ms"));
+	// Exporter is module-wide too; sources that never touched it leave it alone
+	if (obs_data_has_user_value(settings, "metrics_export"))
+		online_status_metrics_configure((int)obs_data_get_int(settings, "metrics_export"),
+						obs_data_get_string(settings, "metrics_path"));
+	if (obs_data_has_user_value(settings, "status_shm"))
+		online_status_shm_configure(obs_data_get_bool(settings, "status_shm"));
+	if (obs_data_has_user_value(settings, "trace_enabled"))
+		online_status_trace_configure(obs_data_get_bool(settings, "trace_enabled"));
+	if (obs_data_has_user_value(settings, "record_samples"))
+		online_status_recorder_configure(obs_data_get_bool(settings, "record_samples"));
+
+	// Triggers
+	detect.signal_enabled[DROP_CAUSE_NETWORK] = obs_data_get_bool(settings, "watch_network");
+	detect.signal_enabled[DROP_CAUSE_ENCODER] = obs_data_get_bool(settings, "watch_encoder");
+	detect.signal_enabled[DROP_CAUSE_RENDER] = obs_data_get_bool(settings, "watch_render");
 
 	// Stable overlay settings
-	s->stable_enabled = obs_data_get_bool(settings, "stable_enabled");
-	s->stable_mode = (int)obs_data_get_int(settings, "stable_mode");
-	s->stable_duration_sec = (float)obs_data_get_double(settings, "stable_duration_sec");
-	const char *stxt = obs_data_get_string(settings, "stable_text");
-	s->stable_text_msg = stxt ? stxt : "";
-	const char *simg = obs_data_get_string(settings, "stable_image_path");
-	s->stable_image_path = simg ? simg : "";
-
-	// Update dropping children
-	update_text_child(s->status_text.get(), s->text);
-	update_image_child(s->status_image.get(), s->image_path);
-
-	// Update stable children
-	update_text_child(s->status_text_stable.get(), s->stable_text_msg);
-	update_image_child(s->status_image_stable.get(), s->stable_image_path);
-
-	// Enable only the active child
-	sync_child_enabled(s);
-}
+	detect.stable_enabled = obs_data_get_bool(settings, "stable_enabled");
+	detect.stable_duration_sec = (float)obs_data_get_double(settings, "stable_duration_sec");
 
-void online_status_video_tick(void *data, float seconds)
-{
-	auto *s = static_cast<OnlineStatus *>(data);
-	if (!s)
-		return;
+	// Early warning
+	detect.degrade_enabled = obs_data_get_bool(settings, "degrade_enabled");
+	detect.trend.congestion_pct = obs_data_get_double(settings, "degrade_congestion_pct");
+	detect.trend.slope_pct_per_sec = obs_data_get_double(settings, "degrade_slope_pct");
+	detect.trend.bitrate_drop_pct = obs_data_get_double(settings, "degrade_bitrate_drop_pct");
 
-	bool streaming_active = false;
-	uint64_t total = 0, dropped = 0;
+	// Reconnecting
+	detect.reconnect_enabled = obs_data_get_bool(settings, "reconnect_enabled");
+	next->reconnect_show_elapsed = obs_data_get_bool(settings, "reconnect_show_elapsed");
 
-	obs_output_t *out = obs_frontend_get_streaming_output();
-	if (out) {
-		streaming_active = obs_output_active(out);
-		if (streaming_active) {
-			// Network dropped/total frames
-			dropped = obs_output_get_frames_dropped(out);
-			total = obs_output_get_total_frames(out);
-		}
-		obs_output_release(out);
-	}
-
-	bool prev_auto_visible = s->auto_visible;
-
-	// Test override: force dropping overlay regardless of streaming state
-	if (s->test_force_drop) {
-		s->auto_visible = true;
-		s->since_last_drop = 0.0f;
-		s->stable_visible = false;
-		s->stable_timer = 0.0f;
-	} else if (!streaming_active) {
-		// Not streaming: reset and hide
-		s->prev_total = s->prev_dropped = 0;
-		s->since_last_drop = 0.0f;
-		s->auto_visible = false;
-		s->stable_visible = false;
-		s->stable_timer = 0.0f;
-	} else {
-		// Reset counters if OBS restarted stats
-		if (total < s->prev_total || dropped < s->prev_dropped) {
-			s->prev_total = total;
-			s->prev_dropped = dropped;
+	next->cache_enabled = obs_data_get_bool(settings, "render_cache");
+
+	// Content and children of every slot (only cause slots can reuse the dropping content),
+	// then hand everything to the graphics thread in one go
+	std::vector<std::shared_ptr<PendingChild>> dropped;
+	std::vector<OnlineStatusConfig *> freed;
+	{
+		std::lock_guard<std::mutex> lock(s->config_mutex);
+		const int policy = link ? OUTPUT_POLICY_STREAMING : (int)obs_data_get_int(settings, "output_policy");
+		next->output_policy = set_output_policy(s, policy);
+		for (int i = 0; i < SLOT_COUNT; i++) {
+			const bool can_share = (i == SLOT_ENCODER || i == SLOT_RENDER);
+			bool in_use = !link;
+			if (i == SLOT_DEGRADING)
+				in_use = in_use && detect.degrade_enabled;
+			else if (i == SLOT_RECONNECTING)
+				in_use = in_use && detect.reconnect_enabled;
+			update_slot(s, &s->slots[i], kSlotKeys[i], settings, can_share, in_use, &dropped);
+			if (s->slots[i].mode == CONTENT_GRAPH)
+				next->graph_in_use = true;
+			if (s->slots[i].mode == CONTENT_TEXT && s->slots[i].text_template)
+				next->templates_in_use = true;
 		}
+		publish_config(s, next, &freed);
+	}
+	for (OnlineStatusConfig *cfg : freed)
+		config_free(cfg);
+	for (const std::shared_ptr<PendingChild> &pending : dropped)
+		cancel_pending_image(pending);
+}
 
-		uint64_t d_total = total - s->prev_total;
-		uint64_t d_drop = dropped - s->prev_dropped;
-		s->prev_total = total;
-		s->prev_dropped = dropped;
+// The group takes the settings of the member edited last, like the module-wide settings
+void online_status_update(void *data, obs_data_t *settings)
+{
+	auto *s = static_cast<OnlineStatus *>(data);
+	TraceScope scope(s->trace, TRACE_UPDATE);
+	s->link = online_status_link_join(s, s->link, obs_data_get_string(settings, "link_group"));
+	if (s->link)
+		apply_settings(s->link->engine, settings, nullptr);
+	apply_settings(s, settings, s->link);
+}
 
-		bool spiked = false;
-		if (d_total > 0 && d_drop > 0) {
-			double pct = (double)d_drop * 100.0 / (double)d_total;
-			spiked = (pct >= s->drop_threshold_pct);
-		}
+void online_status_post_command(OnlineStatus *s, uint32_t command)
+{
+	OnlineStatus *target = s->link ? s->link->engine : s;
+	target->commands.fetch_or(command, std::memory_order_relaxed);
+}
 
-		if (spiked) {
-			s->auto_visible = true;
-			s->since_last_drop = 0.0f;
-			// Any new drop cancels stable overlay
-			s->stable_visible = false;
-			s->stable_timer = 0.0f;
-		} else {
-			s->since_last_drop += seconds;
-			if (s->since_last_drop >= s->hide_after_sec) {
-				s->auto_visible = false;
-			}
-		}
+// Whether update() left a slot's content and children as they were
+static inline bool same_slot(const SlotConfig &a, const SlotConfig &b)
+{
+	return a.mode == b.mode && a.text_child == b.text_child && a.image_child == b.image_child &&
+	       a.image == b.image && a.text_template == b.text_template && a.text == b.text;
+}
 
-		// Handle transition to stable overlay
-		if (s->stable_enabled) {
-			if (prev_auto_visible && !s->auto_visible) {
-				s->stable_visible = true;
-				s->stable_timer = s->stable_duration_sec;
-			}
-			if (s->stable_visible) {
-				s->stable_timer -= seconds;
-				if (s->stable_timer <= 0.0f) {
-					s->stable_visible = false;
-					s->stable_timer = 0.0f;
-				}
-			}
+// Pick up a newly published snapshot (never blocks; the writer frees the old one later).
+// Slots update() did not touch keep their children's state, so a slider drag does not
+// restart animations or redraw cached content.
+static void adopt_config(OnlineStatus *s, const OnlineStatusConfig *cfg)
+{
+	// Compare before announcing the new snapshot; the writer may free the old one after that
+	const OnlineStatusConfig *prev = s->cfg;
+	bool slot_changed[SLOT_COUNT];
+	bool content_changed = !prev || prev->reconnect_show_elapsed != cfg->reconnect_show_elapsed;
+	for (int i = 0; i < SLOT_COUNT; i++) {
+		slot_changed[i] = !prev || !same_slot(prev->slots[i], cfg->slots[i]);
+		content_changed = content_changed || slot_changed[i];
+	}
+	s->cfg = cfg;
+	s->config_seen.store(cfg->gen, std::memory_order_release);
+	if (cfg->output_policy != s->active_policy) {
+		// Counters of the new policy are unrelated to the previous ones
+		if (s->active_policy >= 0)
+			drop_detector_rebase(&s->det);
+		s->active_policy = cfg->output_policy;
+	}
+	if (cfg->graph_span_sec != s->graph_span_sec) {
+		sparkline_reset(&s->graph_history, cfg->graph_span_sec);
+		s->graph_span_sec = cfg->graph_span_sec;
+	}
+	// update() reset the text child of every changed slot to its template with empty values
+	for (int i = 0; i < SLOT_COUNT; i++) {
+		const SlotConfig &slot = cfg->slots[i];
+		if (!slot_changed[i])
+			continue;
+		if (slot.text_template) {
+			const TemplateValues empty;
+			text_template_render(slot.text_template.get(), &empty, &s->template_text[i]);
 		} else {
-			s->stable_visible = false;
-			s->stable_timer = 0.0f;
+			s->template_text[i].clear();
 		}
 	}
+	if (slot_changed[SLOT_RECONNECTING])
+		s->reconnect_suffixed = false;
+	s->template_slot = -1;
+	if (!content_changed)
+		return;
+	s->content_gen++;
+	s->shown_slot = -2;
+	s->reconnect_shown_sec = -1;
+}
 
-	// Blink update (separate)
-	if (s->drop_blink_enabled && s->drop_blink_rate_hz > 0.0) {
-		const double period_d = 1.0 / s->drop_blink_rate_hz;
-		s->drop_blink_phase += seconds;
-		if (s->drop_blink_phase >= period_d)
-			s->drop_blink_phase = fmod(s->drop_blink_phase, period_d);
-		s->drop_blink_on = (s->drop_blink_phase < (period_d * 0.5));
-	} else {
-		s->drop_blink_on = true;
-		s->drop_blink_phase = 0.0;
-	}
-	if (s->stable_blink_enabled && s->stable_blink_rate_hz > 0.0) {
-		const double period_s = 1.0 / s->stable_blink_rate_hz;
-		s->stable_blink_phase += seconds;
-		if (s->stable_blink_phase >= period_s)
-			s->stable_blink_phase = fmod(s->stable_blink_phase, period_s);
-		s->stable_blink_on = (s->stable_blink_phase < (period_s * 0.5));
-	} else {
-		s->stable_blink_on = true;
-		s->stable_blink_phase = 0.0;
+// source plays the audio cues and names incidents
+static void tick(OnlineStatus *s, const OnlineStatusConfig *cfg, obs_source_t *source, float seconds)
+{
+	if (!cfg)
+		return;
+	s->frame++;
+
+	// Idle: same settings, no new snapshot since an inactive one, nothing on screen or
+	// counting down and no test button pressed
+	if (cfg == s->cfg && s->commands.load(std::memory_order_relaxed) == 0 && !s->last_sample_active &&
+	    !cfg->visible && online_status_sampler_seq() == s->last_sample_seq &&
+	    drop_detector_idle(&s->det, &cfg->detect)) {
+		online_status_recorder_idle(s->recorder, seconds);
+		publish_plan_size(s);
+		return;
+	}
+
+	const int prev_policy = s->active_policy;
+	if (cfg != s->cfg)
+		adopt_config(s, cfg);
+	const bool rebased = prev_policy >= 0 && prev_policy != s->active_policy;
+	const uint32_t commands = s->commands.exchange(0, std::memory_order_relaxed);
+	if (commands)
+		drop_detector_apply_commands(&s->det, &cfg->detect, commands);
+
+	// Stats come from the shared sampler; no frontend/output calls per instance
+	OutputStatsSnapshot snap;
+	DropSample sample;
+	if (online_status_sampler_read(&snap)) {
+		const PolicyStats &stats = snap.by_policy[cfg->output_policy];
+		sample.active = stats.active;
+		sample.reconnecting = snap.stream_state == STREAM_STATE_RECONNECTING;
+		sample.fresh = snap.seq != s->last_sample_seq;
+		sample.timestamp_ns = snap.timestamp_ns;
+		sample.counters[DROP_CAUSE_NETWORK].total = stats.total;
+		sample.counters[DROP_CAUSE_NETWORK].dropped = stats.dropped;
+		sample.counters[DROP_CAUSE_ENCODER] = snap.encoder;
+		sample.counters[DROP_CAUSE_RENDER] = snap.render;
+		sample.congestion = stats.congestion;
+		sample.total_bytes = stats.total_bytes;
+		s->last_sample_seq = snap.seq;
 	}
+	s->last_sample_active = sample.active;
 
-	// Keep children enabled in sync with selected mode, blink and stable state
+	drop_detector_tick(&s->det, &cfg->detect, &sample, seconds);
+	online_status_recorder_tick(s->recorder, cfg->gen, &cfg->detect, commands, rebased, &sample, seconds);
+	if (cfg->graph_in_use)
+		sparkline_push(&s->graph_history, &sample);
+	online_status_incidents_tick(&s->incidents, cfg->output_policy, &s->det, &sample,
+				     kPolicyLabels[cfg->output_policy], source ? obs_source_get_name(source) : nullptr);
+
+	if (drop_detector_reconnecting_on(&s->det, &cfg->detect))
+		update_reconnect_text(s);
+	else
+		s->reconnect_shown_sec = -1;
+
+	// Keep children enabled in sync with selected mode and state; animations restart with
+	// every change of the shown slot
+	const int prev_shown = s->shown_slot;
 	sync_child_enabled(s);
+	if (s->shown_slot != prev_shown)
+		update_audio_cue(s, source);
+	if (cfg->templates_in_use) {
+		template_meter_push(&s->template_meter, &sample);
+		refresh_template_text(s, seconds);
+	}
+	s->anim_time = (s->shown_slot == prev_shown) ? s->anim_time + seconds : 0.0;
+	build_render_plan(s);
+	publish_plan_size(s);
 }
 
-// Create the OnlineStatus instance and its children ( text and image sources )
-void *online_status_create(obs_data_t *settings, obs_source_t *owner)
+// Tick the source, or for a linked member the group's engine once per frame. Returns the
+// instance that ticked, so exporters report a group once, under the engine's entries:
+// the engine when this member drove the group, nullptr when another member did.
+static const OnlineStatus *tick_source(OnlineStatus *s, float seconds, bool *linked)
 {
-	UNUSED_PARAMETER(owner);
-	auto *s = new OnlineStatus();
-
-	const char *drop_text = obs_data_get_string(settings, "status_text");
-	const char *drop_image = obs_data_get_string(settings, "image_path");
-	const char *stable_text = obs_data_get_string(settings, "stable_text");
-	const char *stable_img = obs_data_get_string(settings, "stable_image_path");
+	const OnlineStatusConfig *cfg = s->config.load(std::memory_order_acquire);
+	*linked = cfg && cfg->link;
+	if (!*linked) {
+		tick(s, cfg, s->owner, seconds);
+		return s;
+	}
+	// Nothing of its own to show; hold the snapshot so the group stays alive. The engine
+	// measures for the group, so the member's own windows can go.
+	if (cfg != s->cfg) {
+		if (!s->cfg || !s->cfg->link)
+			drop_detector_reset(&s->det);
+		s->cfg = cfg;
+		s->config_seen.store(cfg->gen, std::memory_order_release);
+	}
+	LinkGroup *group = cfg->link.get();
+	OnlineStatus *engine = group->engine;
+	// Members tick one after another on the graphics thread. A live member takes over from a
+	// driver that is not live, and any member from one that stopped ticking the engine (e.g.
+	// it just left); from the next frame on, so the engine never ticks twice in one. Only a
+	// member that can play the group's sounds counts as live.
+	const bool live = s->plays_sound && obs_source_active(s->owner);
+	const OnlineStatus *ticked = nullptr;
+	if (group->driver.load(std::memory_order_relaxed) == s) {
+		group->driver_live.store(live, std::memory_order_relaxed);
+		tick(engine, engine->config.load(std::memory_order_acquire), s->owner, seconds);
+		ticked = engine;
+	} else {
+		const bool stalled = engine->frame == s->engine_frame_seen;
+		if (stalled || (live && !group->driver_live.load(std::memory_order_relaxed))) {
+			group->driver.store(s, std::memory_order_relaxed);
+			group->driver_live.store(live, std::memory_order_relaxed);
+		}
+	}
+	s->engine_frame_seen = engine->frame;
+	s->width.store(engine->width.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	s->height.store(engine->height.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	return ticked;
+}
 
-	// Create dropping children
-	s->status_text.reset(create_text_child_raw("online-status:text", drop_text));
-	s->status_image.reset(create_image_child_raw("online-status:image", drop_image));
+void online_status_video_tick(void *data, float seconds)
+{
+	auto *s = static_cast<OnlineStatus *>(data);
+	if (!s)
+		return;
+	TraceScope scope(s->trace, TRACE_TICK);
+	const uint64_t start_ns = online_status_metrics_enabled() ? os_gettime_ns() : 0;
+	bool linked;
+	const OnlineStatus *ticked = tick_source(s, seconds, &linked);
+	if (linked) {
+		online_status_metrics_hide(s->metrics);
+		online_status_shm_hide(s->status);
+	}
+	if (!ticked)
+		return;
+	const DropDetectorConfig *detect = ticked->cfg ? &ticked->cfg->detect : nullptr;
+	if (start_ns)
+		online_status_metrics_tick(ticked->metrics, &ticked->det, detect, ticked->last_sample_active, seconds,
+					   os_gettime_ns() - start_ns);
+	online_status_shm_tick(ticked->status, &ticked->det, detect, ticked->last_sample_active,
+			       online_status_incidents_seq(ticked->active_policy));
+}
 
-	// Create stable children
-	s->status_text_stable.reset(create_text_child_raw("online-status:text-stable", stable_text));
-	s->status_image_stable.reset(create_image_child_raw("online-status:image-stable", stable_img));
+// Keep the metrics, status, trace and recorder labels in sync with the source name
+static void on_source_rename(void *data, calldata_t *cd)
+{
+	auto *s = static_cast<OnlineStatus *>(data);
+	online_status_metrics_rename(s->metrics, calldata_string(cd, "new_name"));
+	online_status_shm_rename(s->status, calldata_string(cd, "new_name"));
+	online_status_trace_rename(s->trace, calldata_string(cd, "new_name"));
+	online_status_recorder_rename(s->recorder, calldata_string(cd, "new_name"));
+}
 
+// Create the OnlineStatus instance; update() creates the children ( text and image sources )
+void *online_status_create(obs_data_t *settings, obs_source_t *owner)
+{
+	auto *s = new OnlineStatus();
+	s->owner = owner;
+	s->plays_sound = owner && (obs_source_get_output_flags(owner) & OBS_SOURCE_AUDIO);
+	s->metrics = online_status_metrics_register(owner ? obs_source_get_name(owner) : nullptr);
+	s->status = online_status_shm_register(owner ? obs_source_get_name(owner) : nullptr);
+	s->trace = online_status_trace_register(owner ? obs_source_get_name(owner) : nullptr);
+	s->recorder = online_status_recorder_register(owner ? obs_source_get_name(owner) : nullptr);
+	if (owner)
+		signal_handler_connect(obs_source_get_signal_handler(owner), "rename", on_source_rename, s);
 	online_status_update(s, settings);
 	return s;
 }
@@ -317,80 +966,228 @@ void *online_status_create(obs_data_t *settings, obs_source_t *owner)
 void online_status_destroy(void *data)
 {
 	auto *s = static_cast<OnlineStatus *>(data);
+	if (!s)
+		return;
+	if (s->owner)
+		signal_handler_disconnect(obs_source_get_signal_handler(s->owner), "rename", on_source_rename, s);
+	// The group goes away with the last snapshot that names it
+	online_status_link_join(s, s->link, nullptr);
+	s->link.reset();
+	online_status_metrics_unregister(s->metrics);
+	online_status_shm_unregister(s->status);
+	online_status_trace_unregister(s->trace);
+	online_status_recorder_unregister(s->recorder);
+	online_status_incidents_leave(&s->incidents);
+	if (s->output_policy != OUTPUT_POLICY_STREAMING)
+		online_status_sampler_track_all_outputs(false);
+	for (OverlaySlot &slot : s->slots) {
+		if (slot.pending_image)
+			cancel_pending_image(slot.pending_image);
+		online_status_image_release(slot.image);
+	}
+	// Nothing renders any more, so every snapshot can go
+	for (OnlineStatusConfig *cfg : s->retired)
+		config_free(cfg);
+	if (OnlineStatusConfig *cfg = s->config.load(std::memory_order_relaxed))
+		config_free(cfg);
+	if (s->cache.texrender || s->graph.vb) {
+		obs_enter_graphics();
+		if (s->cache.texrender)
+			gs_texrender_destroy(s->cache.texrender);
+		online_status_graph_free(&s->graph);
+		obs_leave_graphics();
+	}
 	delete s; // smart pointers release automatically
 }
+
 uint32_t online_status_get_width(void *data)
 {
 	auto *s = static_cast<OnlineStatus *>(data);
-	if (!s)
-		return 0;
-	const bool show_alert = should_show_dropping(s);
-	const bool show_stable = should_show_stable(s);
-	if (show_alert) {
-		if (s->content_mode == 1 && s->status_image.get())
-			return obs_source_get_width(s->status_image.get());
-		return s->status_text.get() ? obs_source_get_width(s->status_text.get()) : 0;
-	}
-	if (show_stable) {
-		if (s->stable_mode == 1 && s->status_image_stable.get())
-			return obs_source_get_width(s->status_image_stable.get());
-		return s->status_text_stable.get() ? obs_source_get_width(s->status_text_stable.get()) : 0;
-	}
-	// Fallback to dropping-mode size
-	if (s->content_mode == 1 && s->status_image.get())
-		return obs_source_get_width(s->status_image.get());
-	return s->status_text.get() ? obs_source_get_width(s->status_text.get()) : 0;
+	return s ? s->width.load(std::memory_order_relaxed) : 0;
 }
 
 uint32_t online_status_get_height(void *data)
 {
 	auto *s = static_cast<OnlineStatus *>(data);
-	if (!s)
-		return 0;
-	const bool show_alert = should_show_dropping(s);
-	const bool show_stable = should_show_stable(s);
-	if (show_alert) {
-		if (s->content_mode == 1 && s->status_image.get())
-			return obs_source_get_height(s->status_image.get());
-		return s->status_text.get() ? obs_source_get_height(s->status_text.get()) : 0;
-	}
-	if (show_stable) {
-		if (s->stable_mode == 1 && s->status_image_stable.get())
-			return obs_source_get_height(s->status_image_stable.get());
-		return s->status_text_stable.get() ? obs_source_get_height(s->status_text_stable.get()) : 0;
-	}
-	if (s->content_mode == 1 && s->status_image.get())
-		return obs_source_get_height(s->status_image.get());
-	return s->status_text.get() ? obs_source_get_height(s->status_text.get()) : 0;
+	return s ? s->height.load(std::memory_order_relaxed) : 0;
+}
+
+// One quad with the shared texture; nothing until the first decode is uploaded
+static void render_image(CachedImage *image)
+{
+	gs_texture_t *tex = online_status_image_texture(image);
+	if (!tex)
+		return;
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), tex);
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(tex, 0, 0, 0);
+}
+
+// Texture of the shown child. Cacheable children are only rendered again when they, their
+// size or their settings changed, so a static alert becomes a single textured quad. Linked
+// members share the engine's cache, so a redraw happens at most once per frame however many
+// members draw it.
+static gs_texture_t *child_texture(OnlineStatus *s)
+{
+	const RenderPlan &plan = s->plan;
+	RenderCache &cache = s->cache;
+	if (!plan.child || !plan.cx || !plan.cy)
+		return nullptr;
+	if (!cache.texrender)
+		cache.texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+	if (!cache.texrender)
+		return nullptr;
+
+	if (cache.child != plan.child || cache.cx != plan.cx || cache.cy != plan.cy ||
+	    cache.content_gen != s->content_gen) {
+		cache.child = plan.child;
+		cache.cx = plan.cx;
+		cache.cy = plan.cy;
+		cache.content_gen = s->content_gen;
+		// Text sources rebuild their texture on their own tick; catch up for a couple of frames
+		cache.redraw_frames = 2;
+	}
+	if (!plan.cacheable && cache.redraw_frames < 1)
+		cache.redraw_frames = 1;
+
+	if (cache.redraw_frames > 0 && cache.drawn_frame != s->frame) {
+		cache.redraw_frames--;
+		cache.drawn_frame = s->frame;
+		gs_texrender_reset(cache.texrender);
+		if (gs_texrender_begin(cache.texrender, plan.cx, plan.cy)) {
+			struct vec4 clear;
+			vec4_zero(&clear);
+			gs_clear(GS_CLEAR_COLOR, &clear, 0.0f, 0);
+			gs_ortho(0.0f, (float)plan.cx, 0.0f, (float)plan.cy, -100.0f, 100.0f);
+			// Store premultiplied alpha so the cached quad blends like the child did
+			gs_blend_state_push();
+			gs_blend_function_separate(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA, GS_BLEND_ONE,
+						   GS_BLEND_INVSRCALPHA);
+			obs_source_video_render(plan.child);
+			gs_blend_state_pop();
+			gs_texrender_end(cache.texrender);
+		}
+	}
+	return gs_texrender_get_texture(cache.texrender);
 }
+
+static void draw_premultiplied(gs_texture_t *tex, uint32_t cx, uint32_t cy)
+{
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_PREMULTIPLIED_ALPHA);
+	gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), tex);
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(tex, 0, cx, cy);
+	gs_blend_state_pop();
+}
+
+// Animated overlays are one draw of the overlay texture through the animation effect;
+// false means draw without animation
+static bool render_animated(OnlineStatus *s)
+{
+	const RenderPlan &plan = s->plan;
+	gs_texture_t *tex;
+	uint32_t cx, cy;
+	bool premultiplied;
+	if (plan.image) {
+		tex = online_status_image_texture(plan.image);
+		online_status_image_size(plan.image, &cx, &cy);
+		premultiplied = false;
+	} else {
+		tex = child_texture(s);
+		cx = plan.cx;
+		cy = plan.cy;
+		premultiplied = true;
+	}
+	if (!tex)
+		return false;
+	return online_status_anim_draw(tex, 0, 0, cx, cy, premultiplied, &plan.anim, s->anim_time);
+}
+
+// Frame of a sprite anim_time seconds after it appeared; GIFs can keep their own timing
+static uint32_t sprite_frame(const OnlineStatus *s, const SpriteAtlas *atlas)
+{
+	if (!atlas->frame_end_ms.empty() && s->cfg->sprite_gif_timing) {
+		const uint64_t loop_ms = atlas->frame_end_ms.back();
+		if (!loop_ms)
+			return 0;
+		const uint32_t t = (uint32_t)((uint64_t)(s->anim_time * 1000.0) % loop_ms);
+		const auto it = std::upper_bound(atlas->frame_end_ms.begin(), atlas->frame_end_ms.end(), t);
+		return (uint32_t)(it - atlas->frame_end_ms.begin());
+	}
+	uint32_t frames = atlas->frames;
+	if (atlas->frame_end_ms.empty() && s->cfg->sprite_frames && s->cfg->sprite_frames < frames)
+		frames = s->cfg->sprite_frames;
+	return (uint32_t)((uint64_t)(s->anim_time * s->cfg->sprite_fps) % frames);
+}
+
+// One frame of the sprite texture, picked by its UV range; the animation applies on top
+static void render_sprite(OnlineStatus *s)
+{
+	const RenderPlan &plan = s->plan;
+	gs_texture_t *tex = online_status_image_texture(plan.image);
+	const SpriteAtlas *atlas = online_status_image_atlas(plan.image);
+	if (!tex || !atlas)
+		return;
+	const uint32_t frame = sprite_frame(s, atlas);
+	const uint32_t x = (frame % atlas->cols) * atlas->frame_cx;
+	const uint32_t y = (frame / atlas->cols) * atlas->frame_cy;
+	if (plan.anim.kind != ANIM_NONE &&
+	    online_status_anim_draw(tex, x, y, atlas->frame_cx, atlas->frame_cy, false, &plan.anim, s->anim_time))
+		return;
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_effect_set_texture(gs_effect_get_param_by_name(effect, "image"), tex);
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite_subregion(tex, 0, x, y, atlas->frame_cx, atlas->frame_cy);
+}
+
 void online_status_video_render(void *data, gs_effect_t * /*effect*/)
 {
 	auto *s = static_cast<OnlineStatus *>(data);
 	if (!s)
 		return;
-	if (should_show_dropping(s)) {
-		if (s->content_mode == 1) {
-			if (s->status_image.get())
-				obs_source_video_render(s->status_image.get());
-		} else {
-			if (s->status_text.get())
-				obs_source_video_render(s->status_text.get());
-		}
+	TraceTrack *trace = s->trace;
+	// Linked members draw the group's plan, children and cached textures
+	const bool linked = s->cfg && s->cfg->link;
+	if (linked)
+		s = s->cfg->link->engine;
+	if (!s->plan.visible)
+		return;
+	TraceScope scope(trace, TRACE_RENDER);
+	const RenderPlan &plan = s->plan;
+	if (plan.graph) {
+		online_status_graph_draw(&s->graph, &s->graph_history,
+					 (float)drop_detector_threshold_pct(&s->det, &s->cfg->detect, DROP_CAUSE_NETWORK));
 		return;
 	}
-	if (should_show_stable(s)) {
-		if (s->stable_mode == 1) {
-			if (s->status_image_stable.get())
-				obs_source_video_render(s->status_image_stable.get());
-		} else {
-			if (s->status_text_stable.get())
-				obs_source_video_render(s->status_text_stable.get());
+	if (plan.sprite) {
+		render_sprite(s);
+		return;
+	}
+	if (plan.anim.kind != ANIM_NONE && render_animated(s))
+		return;
+	if (plan.image) {
+		render_image(plan.image);
+		return;
+	}
+	if (!plan.child)
+		return;
+	// The group renders its child once per frame into the cache; members draw the texture
+	if (linked || (s->cfg->cache_enabled && plan.cacheable)) {
+		if (gs_texture_t *tex = child_texture(s)) {
+			draw_premultiplied(tex, plan.cx, plan.cy);
+			return;
 		}
 	}
+	obs_source_video_render(plan.child);
 }
 
 // online_status_properties is implemented in properties translation unit
 
+// Two ids with the same callbacks: audio output gives a source a strip in the audio mixer
+// even while it is silent, so only sources that play cues opt into it
 static obs_source_info online_status_info = {
 	.id = "online-status",
 	.type = OBS_SOURCE_TYPE_INPUT,
@@ -410,4 +1207,9 @@ static obs_source_info online_status_info = {
 void register_online_status_source(void)
 {
 	obs_register_source(&online_status_info);
+	obs_source_info with_sound = online_status_info;
+	with_sound.id = "online-status-sound";
+	with_sound.output_flags = OBS_SOURCE_VIDEO | OBS_SOURCE_AUDIO;
+	with_sound.get_name = online_status_sound_get_name;
+	obs_register_source(&with_sound);
 }
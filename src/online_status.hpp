@@ -3,8 +3,24 @@
 
 #include <obs-module.h>
 #include <plugin-support.h>
-#include <string>
+#include "core/drop_detector.hpp"
+#include "core/text_template.hpp"
+#include "online_status_anim.hpp"
+#include "online_status_audio.hpp"
+#include "online_status_graph.hpp"
+#include "online_status_image_cache.hpp"
+#include "online_status_incidents.hpp"
+#include "online_status_link.hpp"
+#include "online_status_metrics.hpp"
+#include "online_status_recorder.hpp"
+#include "online_status_shm.hpp"
+#include "online_status_trace.hpp"
+#include <time.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 // Smart wrapper for obs_source_t (calls obs_source_release automatically)
 struct SourceReleaser {
@@ -16,58 +32,196 @@ struct SourceReleaser {
 };
 using SourceHandle = std::unique_ptr<obs_source_t, SourceReleaser>;
 
-// All runtime data is kept in this struct
-struct OnlineStatus {
-	// Dropping children
-	SourceHandle status_text;
-	SourceHandle status_image;
+// Overlay content slots, one per state that can show something
+enum OverlaySlotId {
+	SLOT_DROPPING = 0,     // network drops; also the fallback for the other causes
+	SLOT_ENCODER = 1,      // encoder overload
+	SLOT_RENDER = 2,       // rendering lag
+	SLOT_DEGRADING = 3,    // early warning before frames drop
+	SLOT_RECONNECTING = 4, // output is reconnecting
+	SLOT_STABLE = 5,       // after recovery
+	SLOT_COUNT
+};
 
-	// Stable-state children
-	SourceHandle status_text_stable;
-	SourceHandle status_image_stable;
+// Values of content_mode/stable_mode and the per-cause modes
+enum ContentMode {
+	CONTENT_SAME_AS_DROPPING = -1, // cause slots only
+	CONTENT_TEXT = 0,
+	CONTENT_IMAGE = 1,
+	CONTENT_GRAPH = 2,  // drop %, lag and bitrate sparkline (dropping and stable)
+	CONTENT_SPRITE = 3, // sprite sheet or GIF atlas from the image path (dropping and stable)
+};
+
+// Values of drop_threshold_mode
+enum ThresholdMode {
+	THRESHOLD_FIXED = 0,
+	THRESHOLD_ADAPTIVE = 1, // learned per signal, see core/drop_baseline.hpp
+};
 
-	// Dropping content
+// Values of ui_section, the pseudo-tabs of the properties. Saved with the source, so the
+// original sections keep their numbers; new sections take the next free one.
+enum UiSection {
+	SECTION_DROPPING = 0,
+	SECTION_STABLE = 1,
+	SECTION_ADVANCED = 2,
+	SECTION_CAUSES = 3,
+	SECTION_EARLY_WARNING = 4,
+	SECTION_RECONNECTING = 5,
+};
+
+struct OnlineStatus;
+
+// Image child being created on the loader thread; the loader publishes it once done
+struct PendingChild {
+	std::mutex mutex;
+	OnlineStatus *owner = nullptr; // valid until cancelled
+	bool cancelled = false;        // owner gave up; the loader releases the result
+};
+
+// Content and children of one slot as update() last read them (writer side). Only what the
+// selected mode shows exists: a text child, a static image from the shared cache, or an
+// image child for animated images.
+struct OverlaySlot {
+	int mode = CONTENT_TEXT;
 	std::string text;
+	std::shared_ptr<const TextTemplate> text_template; // compiled text; nullptr without variables
 	std::string image_path;
+	time_t image_mtime = 0; // of the file the image child was loaded from
+	SourceHandle text_child;
+	SourceHandle image_child;
+	CachedImage *image = nullptr;
+	uint32_t sprite_cols = 0; // grid image was acquired with; 0 for a plain image
+	uint32_t sprite_rows = 0;
+	bool animated = false; // image that changes on its own (GIF); needs an image child
+	std::shared_ptr<PendingChild> pending_image;
+};
+
+// A slot as the graphics thread sees it. The snapshot holds its own references, so children
+// stay alive for as long as the graphics thread may still read the snapshot.
+struct SlotConfig {
+	int mode = CONTENT_TEXT;
+	std::string text;
+	std::shared_ptr<const TextTemplate> text_template;
+	obs_source_t *text_child = nullptr;
+	obs_source_t *image_child = nullptr;
+	CachedImage *image = nullptr;
+	bool animated = false;
+};
 
-	// Stable content
-	std::string stable_text_msg;
-	std::string stable_image_path;
+// Immutable settings snapshot. update() builds a new one and publishes it with a single
+// atomic store; the graphics thread picks up the newest one at the start of every tick.
+struct OnlineStatusConfig {
+	uint64_t gen = 0; // publish counter, increases with every snapshot
+	bool visible = false;
+	int output_policy = 0; // OutputPolicy, see online_status_sampler.hpp
+	bool cache_enabled = false;
+	bool reconnect_show_elapsed = true;
+	AnimSettings drop_anim; // dropping/cause slots
+	AnimSettings stable_anim;
+	bool sound[AUDIO_CUE_COUNT] = {}; // play the cue when its overlay appears
+	bool graph_in_use = false;        // some slot shows the graph; keep its history
+	float graph_span_sec = 30.0f;
+	bool templates_in_use = false;    // some text slot has variables
+	float text_refresh_sec = 0.5f;    // at most one re-render of a template per this
+	uint32_t sprite_frames = 0;       // frames of a sheet to play; 0 = every cell
+	float sprite_fps = 12.0f;
+	bool sprite_gif_timing = true; // GIF atlases keep the file's own frame delays
+	DropDetectorConfig detect;
+	SlotConfig slots[SLOT_COUNT];
+	std::shared_ptr<LinkGroup> link; // set on members of a linked group; the rest is unused then
+};
 
-	// Visibility/state
+// What get_width/get_height/video_render use this frame; rebuilt by tick.
+// While hidden it still describes the dropping content so the source bounds do not jump.
+struct RenderPlan {
 	bool visible = false;
-	bool auto_visible = false;
-	int content_mode = 0;            // 0 = text, 1 = image
-	double drop_threshold_pct = 1.0; // show when pct dropped in interval >= this
-	float hide_after_sec = 3.0f;     // hide after this many seconds without drops
-	uint64_t prev_total = 0;
-	uint64_t prev_dropped = 0;
-	float since_last_drop = 0.0f;
-
-	// Blink config/state (separate for dropping and stable overlays)
-	bool drop_blink_enabled = false;
-	double drop_blink_rate_hz = 1.0; // blinks per second
-	double drop_blink_phase = 0.0;   // seconds into current period
-	bool drop_blink_on = true;       // current half-cycle visible?
-
-	bool stable_blink_enabled = false;
-	double stable_blink_rate_hz = 1.0;
-	double stable_blink_phase = 0.0;
-	bool stable_blink_on = true;
-
-	// Stable overlay options/state
-	bool stable_enabled = true;
-	int stable_mode = 0;              // 0=text, 1=image
-	float stable_duration_sec = 3.0f; // how long to show after recovery
-	float stable_timer = 0.0f;
-	bool stable_visible = false;
-
-	// Testing helpers
-	bool test_force_drop = false;
+	obs_source_t *child = nullptr; // text or animated image child
+	CachedImage *image = nullptr;  // static image, drawn instead of a child
+	bool graph = false;            // sparkline, drawn instead of either
+	bool sprite = false;           // image is a sprite; one frame of it is drawn
+	uint32_t cx = 0;               // child size; images report their own
+	uint32_t cy = 0;
+	bool cacheable = false; // child content only changes through our updates
+	AnimSettings anim;      // animation of the shown slot
+};
+
+// Optional texture cache of the shown overlay (graphics thread only)
+struct RenderCache {
+	gs_texrender_t *texrender = nullptr;
+	obs_source_t *child = nullptr; // child the texture holds
+	uint32_t cx = 0;
+	uint32_t cy = 0;
+	uint32_t content_gen = 0; // OnlineStatus::content_gen at the last redraw
+	int redraw_frames = 0;    // frames left to redraw after a change
+	uint64_t drawn_frame = 0; // OnlineStatus::frame of the last redraw
+};
+
+// All runtime data is kept in this struct
+struct OnlineStatus {
+	// Writer side: update() and finished image loads, never the graphics thread
+	std::mutex config_mutex;
+	OverlaySlot slots[SLOT_COUNT];
+	int output_policy = 0;                     // policy registered with the sampler
+	std::shared_ptr<LinkGroup> link;           // linked group this source shows (UI thread)
+	uint64_t config_gen = 0;                   // gen of the newest snapshot
+	std::vector<OnlineStatusConfig *> retired; // replaced snapshots the graphics thread may hold
+
+	// Handoff to the graphics thread
+	std::atomic<OnlineStatusConfig *> config{nullptr}; // newest snapshot
+	std::atomic<uint64_t> config_seen{0};              // gen of the snapshot the graphics thread holds
+	std::atomic<uint32_t> commands{0};                 // DropCommand bits
+	std::atomic<uint32_t> width{0};                    // plan size for get_width/get_height
+	std::atomic<uint32_t> height{0};
+
+	// Graphics thread only
+	const OnlineStatusConfig *cfg = nullptr; // snapshot in use
+	int active_policy = -1;                  // policy the detector's counters belong to
+	uint64_t last_sample_seq = 0;            // last sampler snapshot evaluated
+	bool last_sample_active = false;         // whether that snapshot had an active output
+	int shown_slot = -2;                     // slot whose child is enabled (-1 none, -2 resync)
+	double anim_time = 0.0;                  // time since the shown slot changed
+	uint64_t frame = 0;                      // ticks so far; caches redraw at most once per frame
+	uint64_t engine_frame_seen = 0;          // linked member: engine frame at its last tick
+	int audio_cue = AUDIO_CUE_NONE;          // cue of the shown slot
+	uint64_t audio_until_ns = 0;             // end of the cue last played
+
+	// Render plan and optional texture cache
+	RenderPlan plan;
+	uint32_t content_gen = 0; // bumped whenever a child's settings change
+	RenderCache cache;
+
+	// Graph content mode
+	SparklineHistory graph_history;
+	float graph_span_sec = 0.0f; // span graph_history was reset for
+	GraphRenderer graph;
+
+	// Live text templates: what each text child was last given, so only changes reach it
+	TemplateMeter template_meter;
+	std::string template_text[SLOT_COUNT];
+	std::string template_buf;    // render buffer, swapped with template_text
+	int template_slot = -1;      // slot refreshed last tick
+	float template_timer = 0.0f; // seconds until its next refresh
+
+	// Reconnecting text with elapsed time
+	int reconnect_shown_sec = -1;    // seconds currently in the text (-1 = rewrite on the next tick)
+	bool reconnect_suffixed = false; // the child's text ends in a time
+
+	// Detection (libobs-free core, see core/drop_detector.hpp)
+	DropDetector det;
+	IncidentVote incidents; // its part in the incident log's episodes
+
+	// Exporter counters, see online_status_metrics.hpp
+	obs_source_t *owner = nullptr; // for its name
+	bool plays_sound = false;      // created as "online-status-sound", the id with an audio mixer entry
+	SourceMetrics *metrics = nullptr;
+	SourceStatus *status = nullptr;     // shared memory status entry, see online_status_shm.hpp
+	TraceTrack *trace = nullptr;        // tracer timeline, see online_status_trace.hpp
+	SampleRecorder *recorder = nullptr; // detector input, see online_status_recorder.hpp
 };
 
 // OBS source callbacks
 const char *online_status_get_name(void *);
+const char *online_status_sound_get_name(void *);
 void *online_status_create(obs_data_t *settings, obs_source_t *owner);
 void online_status_destroy(void *data);
 uint32_t online_status_get_width(void *data);
@@ -78,5 +232,8 @@ void online_status_update(void *data, obs_data_t *settings);
 void online_status_video_tick(void *data, float seconds);
 void online_status_video_render(void *data, gs_effect_t *effect);
 
+// Test buttons (UI thread); linked sources post to their group
+void online_status_post_command(OnlineStatus *s, uint32_t command);
+
 // Registration
 void register_online_status_source(void);
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_anim.hpp"
+#include <graphics/vec2.h>
+#include <math.h>
+
+static const char *const kTechniques[ANIM_COUNT][EASING_COUNT] = {
+	{"None", "None", "None"},
+	{"Blink", "Blink", "Blink"},
+	{"FadeLinear", "FadeSmooth", "FadeOut"},
+	{"PulseLinear", "PulseSmooth", "PulseOut"},
+	{"SlideLinear", "SlideSmooth", "SlideOut"},
+};
+
+// Loaded on first use (graphics thread)
+static gs_effect_t *g_effect = nullptr;
+static bool g_load_failed = false;
+static gs_eparam_t *g_param_image = nullptr;
+static gs_eparam_t *g_param_time = nullptr;
+static gs_eparam_t *g_param_rate = nullptr;
+static gs_eparam_t *g_param_size = nullptr;
+static gs_eparam_t *g_param_straight = nullptr;
+
+static bool load_effect(void)
+{
+	if (g_effect)
+		return true;
+	if (g_load_failed)
+		return false;
+
+	char *path = obs_module_file("effects/overlay-anim.effect");
+	char *errors = nullptr;
+	g_effect = path ? gs_effect_create_from_file(path, &errors) : nullptr;
+	if (!g_effect) {
+		blog(LOG_ERROR, "[online-status] Failed to load animation effect: %s", errors ? errors : "(no file)");
+		g_load_failed = true;
+	}
+	bfree(errors);
+	bfree(path);
+	if (!g_effect)
+		return false;
+
+	g_param_image = gs_effect_get_param_by_name(g_effect, "image");
+	g_param_time = gs_effect_get_param_by_name(g_effect, "anim_time");
+	g_param_rate = gs_effect_get_param_by_name(g_effect, "anim_rate");
+	g_param_size = gs_effect_get_param_by_name(g_effect, "anim_size");
+	g_param_straight = gs_effect_get_param_by_name(g_effect, "straight_alpha");
+	return true;
+}
+
+// The effect only uses the phase of a cycle (and saturates one-shot slides after the first),
+// so hand it the time within the current cycle; a float of hours would step in whole frames
+static float effect_time(double anim_time, float rate_hz)
+{
+	if (rate_hz <= 0.0f)
+		return 0.0f;
+	const double cycles = anim_time * rate_hz;
+	if (cycles < 1.0)
+		return (float)anim_time;
+	return (float)((1.0 + (cycles - floor(cycles))) / rate_hz);
+}
+
+bool online_status_anim_draw(gs_texture_t *tex, uint32_t x, uint32_t y, uint32_t cx, uint32_t cy, bool premultiplied,
+			     const AnimSettings *anim, double anim_time)
+{
+	if (!load_effect())
+		return false;
+
+	int kind = anim->kind;
+	if (kind < ANIM_NONE || kind >= ANIM_COUNT)
+		kind = ANIM_NONE;
+	int easing = anim->easing;
+	if (easing < EASING_LINEAR || easing >= EASING_COUNT)
+		easing = EASING_SMOOTH;
+	const char *technique = kTechniques[kind][easing];
+
+	struct vec2 size;
+	vec2_set(&size, (float)cx, (float)cy);
+	gs_effect_set_texture(g_param_image, tex);
+	gs_effect_set_float(g_param_time, effect_time(anim_time, anim->rate_hz));
+	gs_effect_set_float(g_param_rate, anim->rate_hz > 0.0f ? anim->rate_hz : 0.0f);
+	gs_effect_set_vec2(g_param_size, &size);
+	gs_effect_set_float(g_param_straight, premultiplied ? 0.0f : 1.0f);
+
+	gs_blend_state_push();
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+	while (gs_effect_loop(g_effect, technique))
+		gs_draw_sprite_subregion(tex, 0, x, y, cx, cy);
+	gs_blend_state_pop();
+	return true;
+}
+
+void online_status_anim_unload(void)
+{
+	if (g_effect) {
+		obs_enter_graphics();
+		gs_effect_destroy(g_effect);
+		obs_leave_graphics();
+		g_effect = nullptr;
+	}
+	g_load_failed = false;
+}
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <obs-module.h>
+#include <stdint.h>
+
+// Overlay animations, drawn in one pass by data/effects/overlay-anim.effect
+enum OverlayAnim {
+	ANIM_NONE = 0,
+	ANIM_BLINK = 1, // on/off, the former blink setting
+	ANIM_FADE = 2,  // fade out and back in once per cycle
+	ANIM_PULSE = 3, // shrink and dim slightly once per cycle
+	ANIM_SLIDE = 4, // slide in from the left once, then stay
+	ANIM_COUNT
+};
+
+// Easing curve; each one is its own technique, so it is fixed at shader compile time
+enum OverlayEasing {
+	EASING_LINEAR = 0,
+	EASING_SMOOTH = 1, // ease in and out
+	EASING_OUT = 2,    // fast start, slow end
+	EASING_COUNT
+};
+
+struct AnimSettings {
+	int kind = ANIM_NONE;
+	int easing = EASING_SMOOTH;
+	float rate_hz = 1.0f; // cycles per second; slide duration is 1 / rate
+};
+
+// Graphics thread: draw the cx x cy part of tex at x, y (a sprite frame, or all of it from
+// 0, 0), anim_time seconds into the overlay. Returns false if the effect could not be
+// loaded, so the caller can draw without animation.
+bool online_status_anim_draw(gs_texture_t *tex, uint32_t x, uint32_t y, uint32_t cx, uint32_t cy, bool premultiplied,
+			     const AnimSettings *anim, double anim_time);
+
+// obs_module_unload
+void online_status_anim_unload(void);
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_audio.hpp"
+#include <util/platform.h>
+#include <math.h>
+
+static constexpr uint32_t kSampleRate = 48000; // libobs resamples to the mix rate
+static constexpr uint32_t kToneFrames = kSampleRate * 120 / 1000;
+static constexpr uint32_t kGapFrames = kSampleRate * 40 / 1000;
+static constexpr uint32_t kRampFrames = kSampleRate * 5 / 1000; // fade in/out so tones do not click
+static constexpr uint32_t kCueFrames = 2 * kToneFrames + kGapFrames;
+static constexpr float kAmplitude = 0.35f;
+static constexpr double kTwoPi = 6.283185307179586;
+
+// Two tones each, first and second
+static const float kCueTonesHz[AUDIO_CUE_COUNT][2] = {
+	{880.0f, 660.0f}, // dropping
+	{660.0f, 880.0f}, // stable
+};
+
+// Mono float PCM; written once by online_status_audio_init, read-only afterwards
+static float g_cues[AUDIO_CUE_COUNT][kCueFrames];
+
+static void render_tone(float *out, float hz)
+{
+	const double step = kTwoPi * hz / kSampleRate;
+	for (uint32_t i = 0; i < kToneFrames; i++) {
+		float gain = kAmplitude;
+		if (i < kRampFrames)
+			gain *= (float)i / kRampFrames;
+		else if (kToneFrames - i < kRampFrames)
+			gain *= (float)(kToneFrames - i) / kRampFrames;
+		out[i] = gain * (float)sin(step * i);
+	}
+}
+
+void online_status_audio_init(void)
+{
+	for (int c = 0; c < AUDIO_CUE_COUNT; c++) {
+		float *pcm = g_cues[c];
+		render_tone(pcm, kCueTonesHz[c][0]);
+		for (uint32_t i = kToneFrames; i < kToneFrames + kGapFrames; i++)
+			pcm[i] = 0.0f;
+		render_tone(pcm + kToneFrames + kGapFrames, kCueTonesHz[c][1]);
+	}
+}
+
+uint64_t online_status_audio_play(obs_source_t *source, int cue)
+{
+	const uint64_t now = os_gettime_ns();
+	if (!source || cue < 0 || cue >= AUDIO_CUE_COUNT)
+		return now;
+
+	// libobs copies the frames into the source's own buffer before returning
+	struct obs_source_audio audio = {};
+	audio.data[0] = reinterpret_cast<const uint8_t *>(g_cues[cue]);
+	audio.frames = kCueFrames;
+	audio.speakers = SPEAKERS_MONO;
+	audio.format = AUDIO_FORMAT_FLOAT;
+	audio.samples_per_sec = kSampleRate;
+	audio.timestamp = now;
+	obs_source_output_audio(source, &audio);
+	return now + (uint64_t)kCueFrames * 1000000000ULL / kSampleRate;
+}
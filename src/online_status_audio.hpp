@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <obs-module.h>
+#include <stdint.h>
+
+// Short synthesized cues for streamers who do not watch the overlay. Both are rendered once
+// into static PCM buffers at module load; playing one hands a pointer to that buffer to
+// obs_source_output_audio, so the audio path never allocates, locks or decodes. The level
+// comes from the source's own volume in the audio mixer.
+enum AudioCue {
+	AUDIO_CUE_DROPPING = 0, // falling two-tone beep
+	AUDIO_CUE_STABLE = 1,   // rising two-tone beep
+	AUDIO_CUE_COUNT,
+	AUDIO_CUE_NONE = AUDIO_CUE_COUNT
+};
+
+// obs_module_load: synthesize the cues
+void online_status_audio_init(void);
+
+// Graphics thread: push one cue as the audio of source, timestamped now. Returns the time
+// the cue ends (os_gettime_ns clock) so callers can avoid overlapping cues.
+uint64_t online_status_audio_play(obs_source_t *source, int cue);
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_graph.hpp"
+#include <graphics/vec3.h>
+#include <graphics/vec4.h>
+
+// Vertex colors, 0xAABBGGRR
+static const uint32_t kSeriesColors[SPARKLINE_SERIES_COUNT] = {
+	0xFF4040FF, // drop %: red
+	0xFF30D0FF, // lag %: yellow
+	0xFFFFA040, // bitrate: blue
+};
+static const uint32_t kThresholdColor = 0x80FFFFFF; // dim white
+
+// One segment per pair of neighbouring points per series, plus the threshold line
+static constexpr uint32_t kSegmentVerts = 2 * (kSparklinePoints - 1);
+static constexpr uint32_t kVertexCount = SPARKLINE_SERIES_COUNT * kSegmentVerts + 2;
+
+static gs_vertbuffer_t *create_buffer(void)
+{
+	struct gs_vb_data *data = gs_vbdata_create();
+	data->num = kVertexCount;
+	data->points = static_cast<struct vec3 *>(bzalloc(sizeof(struct vec3) * kVertexCount));
+	data->colors = static_cast<uint32_t *>(bzalloc(sizeof(uint32_t) * kVertexCount));
+	for (int s = 0; s < SPARKLINE_SERIES_COUNT; s++)
+		for (uint32_t v = 0; v < kSegmentVerts; v++)
+			data->colors[s * kSegmentVerts + v] = kSeriesColors[s];
+	data->colors[kVertexCount - 2] = kThresholdColor;
+	data->colors[kVertexCount - 1] = kThresholdColor;
+	// The buffer owns data from here on
+	return gs_vertexbuffer_create(data, GS_DYNAMIC);
+}
+
+static inline float to_y(float value, float top)
+{
+	const float frac = top > 0.0f ? value / top : 0.0f;
+	return (float)kGraphHeight * (1.0f - (frac < 0.0f ? 0.0f : frac > 1.0f ? 1.0f : frac));
+}
+
+// Rewrite the positions from the history; percentages share a scale that always shows the
+// threshold, bitrate scales to its own peak
+static void fill_points(struct vec3 *points, const SparklineHistory *history, float threshold_pct)
+{
+	float pct_top = threshold_pct * 2.0f;
+	for (int s = SPARKLINE_DROP; s <= SPARKLINE_LAG; s++) {
+		const float max = sparkline_max(history, s) * 1.1f;
+		if (max > pct_top)
+			pct_top = max;
+	}
+	if (pct_top < 1.0f)
+		pct_top = 1.0f;
+	const float kbps_top = sparkline_max(history, SPARKLINE_BITRATE) * 1.1f;
+
+	const float step = (float)kGraphWidth / (float)(kSparklinePoints - 1);
+	for (int s = 0; s < SPARKLINE_SERIES_COUNT; s++) {
+		const float top = s == SPARKLINE_BITRATE ? kbps_top : pct_top;
+		struct vec3 *out = points + s * kSegmentVerts;
+		float prev_y = to_y(sparkline_value(history, s, 0), top);
+		for (uint32_t i = 1; i < kSparklinePoints; i++) {
+			const float y = to_y(sparkline_value(history, s, i), top);
+			vec3_set(out++, step * (float)(i - 1), prev_y, 0.0f);
+			vec3_set(out++, step * (float)i, y, 0.0f);
+			prev_y = y;
+		}
+	}
+	const float threshold_y = to_y(threshold_pct, pct_top);
+	vec3_set(&points[kVertexCount - 2], 0.0f, threshold_y, 0.0f);
+	vec3_set(&points[kVertexCount - 1], (float)kGraphWidth, threshold_y, 0.0f);
+}
+
+void online_status_graph_draw(GraphRenderer *graph, const SparklineHistory *history, float threshold_pct)
+{
+	if (!graph->vb) {
+		graph->vb = create_buffer();
+		if (!graph->vb)
+			return;
+		graph->gen = history->gen + 1; // force the first fill
+	}
+	if (graph->gen != history->gen || graph->threshold_pct != threshold_pct) {
+		fill_points(gs_vertexbuffer_get_data(graph->vb)->points, history, threshold_pct);
+		gs_vertexbuffer_flush(graph->vb);
+		graph->gen = history->gen;
+		graph->threshold_pct = threshold_pct;
+	}
+
+	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
+	struct vec4 white;
+	vec4_set(&white, 1.0f, 1.0f, 1.0f, 1.0f);
+	gs_effect_set_vec4(gs_effect_get_param_by_name(solid, "color"), &white);
+	gs_load_vertexbuffer(graph->vb);
+	gs_load_indexbuffer(nullptr);
+	while (gs_effect_loop(solid, "SolidColored"))
+		gs_draw(GS_LINES, 0, kVertexCount);
+	gs_load_vertexbuffer(nullptr);
+}
+
+void online_status_graph_free(GraphRenderer *graph)
+{
+	if (graph->vb)
+		gs_vertexbuffer_destroy(graph->vb);
+	*graph = GraphRenderer{};
+}
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <obs-module.h>
+#include <stdint.h>
+#include "core/sparkline.hpp"
+
+// Size of the graph content, in source pixels
+static constexpr uint32_t kGraphWidth = 320;
+static constexpr uint32_t kGraphHeight = 96;
+
+// Line list of the sparkline in one dynamic vertex buffer. The buffer is created once; new
+// points rewrite its positions in place and flush it, and every frame is a single draw.
+struct GraphRenderer {
+	gs_vertbuffer_t *vb = nullptr;
+	uint64_t gen = 0;            // history gen the buffer holds
+	float threshold_pct = -1.0f; // threshold line the buffer holds
+};
+
+// Graphics thread: draw history at kGraphWidth x kGraphHeight with a line at threshold_pct
+void online_status_graph_draw(GraphRenderer *graph, const SparklineHistory *history, float threshold_pct);
+
+// Release the buffer (graphics context held)
+void online_status_graph_free(GraphRenderer *graph);
@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_image_cache.hpp"
+#include "online_status_loader.hpp"
+#include <graphics/image-file.h>
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <sys/stat.h>
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+    Decoding happens on the loader thread. The graphics thread picks up finished decodes the
+    next time the image is drawn, uploads the texture and frees the previous one; it only
+    swaps a pointer and sets a flag, never locks. Every few seconds the loader checks the
+    files of the images drawn since its last check for a new mtime.
+*/
+
+static constexpr uint32_t kRecheckIntervalMs = 2000;
+
+// Largest atlas a GIF is unpacked into; fits the texture limit of every renderer OBS has
+static constexpr uint32_t kMaxAtlasSize = 8192;
+
+// One decode: a file libobs uploads itself, or GIF frames packed for gs_texture_create
+struct DecodedImage {
+	gs_image_file_t file = {};
+	uint8_t *pixels = nullptr; // packed frames (RGBA), freed once uploaded
+	uint32_t cx = 0;           // texture size
+	uint32_t cy = 0;
+	gs_texture_t *texture = nullptr; // of pixels
+	bool sprite = false;
+	SpriteAtlas atlas;
+};
+
+struct CachedImage {
+	std::string key;  // g_cache key
+	std::string path;
+	uint32_t sprite_cols = 0; // sprite grid; 0 for a plain image
+	uint32_t sprite_rows = 0;
+	int refs = 0; // g_cache_mutex
+
+	// Loader handoff
+	std::mutex mutex;
+	std::atomic<DecodedImage *> decoded{nullptr}; // newest decode, not uploaded yet
+	std::atomic<bool> drawn{false};               // texture asked for since the last recheck
+	time_t mtime = 0;                             // file time of the newest requested decode
+	bool requested = false;
+	bool loading = false;
+	bool evicted = false; // last reference dropped; late decodes are thrown away
+
+	// Graphics thread only
+	DecodedImage *shown = nullptr; // uploaded
+
+	std::atomic<uint32_t> cx{0};
+	std::atomic<uint32_t> cy{0};
+};
+
+static std::mutex g_cache_mutex;
+static std::unordered_map<std::string, std::shared_ptr<CachedImage>> g_cache;
+
+// ------------------------ Helpers ------------------------
+static void free_decoded(DecodedImage *image)
+{
+	if (!image)
+		return;
+	obs_enter_graphics();
+	gs_image_file_free(&image->file);
+	if (image->texture)
+		gs_texture_destroy(image->texture);
+	obs_leave_graphics();
+	bfree(image->pixels);
+	delete image;
+}
+
+static time_t file_mtime(const char *path)
+{
+	struct stat st;
+	return os_stat(path, &st) == 0 ? st.st_mtime : 0;
+}
+
+// Display time of a GIF frame, the way libobs plays it
+static uint64_t gif_frame_ns(const gs_image_file_t *file, int frame)
+{
+	const uint64_t delay = (uint64_t)file->gif.frames[frame].frame_delay * 10000000ULL;
+	return delay ? delay : 100000000ULL;
+}
+
+// Unpack every frame of an animated GIF into a grid. libobs decodes frames in order into
+// its frame cache as the file is ticked, so it is ticked one frame delay at a time.
+static bool pack_gif(DecodedImage *image, const char *path)
+{
+	gs_image_file_t *file = &image->file;
+	const uint32_t fcx = file->cx;
+	const uint32_t fcy = file->cy;
+	const uint32_t count = file->gif.frame_count;
+	if (!fcx || !fcy || !count || !file->animation_frame_cache)
+		return false;
+	uint32_t cols = (uint32_t)ceil(sqrt((double)count));
+	if (cols * fcx > kMaxAtlasSize)
+		cols = kMaxAtlasSize / fcx;
+	const uint32_t rows = cols ? (count + cols - 1) / cols : 0;
+	if (!cols || rows * fcy > kMaxAtlasSize) {
+		blog(LOG_WARNING, "[online-status] '%s' has too many frames for one texture; use a sprite sheet", path);
+		return false;
+	}
+
+	image->cx = cols * fcx;
+	image->cy = rows * fcy;
+	image->pixels = static_cast<uint8_t *>(bzalloc((size_t)image->cx * image->cy * 4));
+	SpriteAtlas &atlas = image->atlas;
+	atlas.cols = cols;
+	atlas.frame_cx = fcx;
+	atlas.frame_cy = fcy;
+	atlas.frames = 0;
+	uint64_t end_ms = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (i > 0)
+			gs_image_file_tick(file, gif_frame_ns(file, file->cur_frame) + 1);
+		const uint8_t *frame = file->cur_frame == (int)i ? file->animation_frame_cache[i] : nullptr;
+		if (!frame)
+			break; // keep what decoded
+		uint8_t *dst = image->pixels + ((size_t)(i / cols) * fcy * image->cx + (size_t)(i % cols) * fcx) * 4;
+		for (uint32_t y = 0; y < fcy; y++)
+			memcpy(dst + (size_t)y * image->cx * 4, frame + (size_t)y * fcx * 4, (size_t)fcx * 4);
+		end_ms += gif_frame_ns(file, (int)i) / 1000000ULL;
+		atlas.frame_end_ms.push_back((uint32_t)end_ms);
+		atlas.frames++;
+	}
+
+	// The decoder and its frame cache are no longer needed
+	obs_enter_graphics();
+	gs_image_file_free(file);
+	obs_leave_graphics();
+	memset(file, 0, sizeof(*file));
+	return atlas.frames > 0;
+}
+
+// Sprite layout of a decoded file
+static bool make_sprite(DecodedImage *image, uint32_t cols, uint32_t rows, const char *path)
+{
+	image->sprite = true;
+	if (image->file.is_animated_gif)
+		return pack_gif(image, path);
+	SpriteAtlas &atlas = image->atlas;
+	atlas.cols = cols;
+	atlas.frames = cols * rows;
+	atlas.frame_cx = image->cx / cols;
+	atlas.frame_cy = image->cy / rows;
+	if (!atlas.frame_cx || !atlas.frame_cy) {
+		blog(LOG_WARNING, "[online-status] '%s' is smaller than its %ux%u sprite grid", path, cols, rows);
+		return false;
+	}
+	return true;
+}
+
+static void decode_job(const std::shared_ptr<CachedImage> &entry)
+{
+	auto *image = new DecodedImage();
+	gs_image_file_init(&image->file, entry->path.c_str());
+	image->cx = image->file.cx;
+	image->cy = image->file.cy;
+	bool ok = image->file.loaded;
+	if (!ok)
+		blog(LOG_WARNING, "[online-status] Failed to load image '%s'", entry->path.c_str());
+	else if (entry->sprite_cols)
+		ok = make_sprite(image, entry->sprite_cols, entry->sprite_rows, entry->path.c_str());
+	if (!ok) {
+		free_decoded(image);
+		image = nullptr;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(entry->mutex);
+		entry->loading = false;
+		if (!entry->evicted && image) {
+			entry->cx.store(image->sprite ? image->atlas.frame_cx : image->cx, std::memory_order_relaxed);
+			entry->cy.store(image->sprite ? image->atlas.frame_cy : image->cy, std::memory_order_relaxed);
+			image = entry->decoded.exchange(image, std::memory_order_acq_rel);
+		}
+	}
+	// Evicted meanwhile, or an older decode that was never drawn
+	free_decoded(image);
+}
+
+// Queue a decode if the file is new to the entry or changed on disk
+static void request_if_changed(const std::shared_ptr<CachedImage> &entry)
+{
+	const time_t mtime = file_mtime(entry->path.c_str());
+	std::lock_guard<std::mutex> lock(entry->mutex);
+	if (entry->evicted || entry->loading || (entry->requested && mtime == entry->mtime))
+		return;
+	entry->requested = true;
+	entry->loading = true;
+	entry->mtime = mtime;
+	online_status_loader_submit([entry] { decode_job(entry); });
+}
+
+// Graphics thread: create the texture of a fresh decode
+static void upload(DecodedImage *image)
+{
+	if (!image->pixels) {
+		gs_image_file_init_texture(&image->file);
+		return;
+	}
+	const uint8_t *data = image->pixels;
+	image->texture = gs_texture_create(image->cx, image->cy, GS_RGBA, 1, &data, 0);
+	bfree(image->pixels);
+	image->pixels = nullptr;
+}
+
+// Loader thread: look for changed files of the images on screen
+static void recheck_drawn(void)
+{
+	std::vector<std::shared_ptr<CachedImage>> drawn;
+	{
+		std::lock_guard<std::mutex> lock(g_cache_mutex);
+		for (const auto &it : g_cache) {
+			if (it.second->drawn.exchange(false, std::memory_order_relaxed))
+				drawn.push_back(it.second);
+		}
+	}
+	for (const std::shared_ptr<CachedImage> &entry : drawn)
+		request_if_changed(entry);
+}
+
+static CachedImage *acquire(const std::string &key, const char *path, uint32_t cols, uint32_t rows)
+{
+	static std::once_flag recheck_once;
+	std::call_once(recheck_once, [] { online_status_loader_every(kRecheckIntervalMs, recheck_drawn); });
+
+	std::shared_ptr<CachedImage> entry;
+	{
+		std::lock_guard<std::mutex> lock(g_cache_mutex);
+		std::shared_ptr<CachedImage> &slot = g_cache[key];
+		if (!slot) {
+			slot = std::make_shared<CachedImage>();
+			slot->key = key;
+			slot->path = path;
+			slot->sprite_cols = cols;
+			slot->sprite_rows = rows;
+		}
+		slot->refs++;
+		entry = slot;
+	}
+	request_if_changed(entry);
+	return entry.get();
+}
+
+// ------------------------ API ------------------------
+CachedImage *online_status_image_acquire(const char *path)
+{
+	if (!path || !*path)
+		return nullptr;
+	return acquire(path, path, 0, 0);
+}
+
+CachedImage *online_status_sprite_acquire(const char *path, uint32_t cols, uint32_t rows)
+{
+	if (!path || !*path)
+		return nullptr;
+	cols = cols ? cols : 1;
+	rows = rows ? rows : 1;
+	// Sprites decode differently from the plain image of the same file
+	const std::string key = "sprite:" + std::to_string(cols) + "x" + std::to_string(rows) + ":" + path;
+	return acquire(key, path, cols, rows);
+}
+
+CachedImage *online_status_image_ref(CachedImage *image)
+{
+	if (!image)
+		return nullptr;
+	std::lock_guard<std::mutex> lock(g_cache_mutex);
+	image->refs++;
+	return image;
+}
+
+void online_status_image_release(CachedImage *image)
+{
+	if (!image)
+		return;
+
+	std::shared_ptr<CachedImage> entry;
+	{
+		std::lock_guard<std::mutex> lock(g_cache_mutex);
+		if (--image->refs > 0)
+			return;
+		auto it = g_cache.find(image->key);
+		entry = std::move(it->second);
+		g_cache.erase(it);
+	}
+
+	DecodedImage *decoded;
+	{
+		std::lock_guard<std::mutex> lock(entry->mutex);
+		entry->evicted = true;
+		decoded = entry->decoded.exchange(nullptr, std::memory_order_acquire);
+	}
+	free_decoded(decoded);
+	free_decoded(entry->shown);
+	entry->shown = nullptr;
+}
+
+gs_texture_t *online_status_image_texture(CachedImage *image)
+{
+	if (!image)
+		return nullptr;
+
+	DecodedImage *fresh = image->decoded.exchange(nullptr, std::memory_order_acquire);
+	if (fresh) {
+		upload(fresh);
+		std::swap(image->shown, fresh);
+		free_decoded(fresh);
+	}
+
+	// Checked for changes by the loader; only an image in use is worth the stat
+	image->drawn.store(true, std::memory_order_relaxed);
+	if (!image->shown)
+		return nullptr;
+	return image->shown->texture ? image->shown->texture : image->shown->file.texture;
+}
+
+const SpriteAtlas *online_status_image_atlas(const CachedImage *image)
+{
+	return image && image->shown && image->shown->sprite ? &image->shown->atlas : nullptr;
+}
+
+void online_status_image_size(const CachedImage *image, uint32_t *cx, uint32_t *cy)
+{
+	*cx = image ? image->cx.load(std::memory_order_relaxed) : 0;
+	*cy = image ? image->cy.load(std::memory_order_relaxed) : 0;
+}
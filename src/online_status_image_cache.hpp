@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <obs-module.h>
+#include <stdint.h>
+#include <vector>
+
+// Process-wide cache of static overlay images, keyed by path. Every source showing the same
+// file shares one decoded copy and one texture; an entry is freed with its last reference
+// and decoded again when the file changes on disk.
+struct CachedImage;
+
+// Frames of a sprite, laid out row by row from the top left of one texture
+struct SpriteAtlas {
+	uint32_t cols = 1; // frames per row
+	uint32_t frames = 1;
+	uint32_t frame_cx = 0;
+	uint32_t frame_cy = 0;
+	std::vector<uint32_t> frame_end_ms; // GIFs: end of each frame within one loop; empty for sheets
+};
+
+// Take a reference; a new or changed file is decoded on the loader thread
+CachedImage *online_status_image_acquire(const char *path);
+
+// Same for a sprite: a sheet of cols x rows equal frames, or an animated GIF whose frames
+// are unpacked once into a grid. Either way every frame lives in one texture.
+CachedImage *online_status_sprite_acquire(const char *path, uint32_t cols, uint32_t rows);
+
+// Take another reference to an image that is already held
+CachedImage *online_status_image_ref(CachedImage *image);
+
+// Drop a reference. The last one frees the texture, so call it where the image can no
+// longer be drawn.
+void online_status_image_release(CachedImage *image);
+
+// Graphics thread: current texture, uploaded on first use; nullptr until decoded
+gs_texture_t *online_status_image_texture(CachedImage *image);
+
+// Graphics thread, after online_status_image_texture: layout of the uploaded sprite; nullptr
+// for plain images and until the first upload
+const SpriteAtlas *online_status_image_atlas(const CachedImage *image);
+
+// Size of the newest decode (of one frame for sprites), 0x0 until the first one finished
+void online_status_image_size(const CachedImage *image, uint32_t *cx, uint32_t *cy);
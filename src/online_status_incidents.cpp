@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_incidents.hpp"
+#include "online_status_sampler.hpp"
+#include <obs-module.h>
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <atomic>
+
+static IncidentLog g_log;
+static bool g_open = false;
+
+// One watched output's episodes. Trackers are only ticked on the graphics thread; votes are
+// atomic because a source may be destroyed on another thread, which then leaves closing
+// the record to the next tick.
+struct PolicyIncidents {
+	IncidentTracker tracker;
+	std::atomic<uint32_t> votes[INCIDENT_KIND_COUNT] = {}; // sources showing each kind
+};
+
+static PolicyIncidents g_policies[OUTPUT_POLICY_COUNT];
+static std::atomic<bool> g_unsettled{false}; // a vote was withdrawn off the graphics thread
+
+void online_status_incidents_open(void)
+{
+	if (g_open)
+		return;
+	char *dir = obs_module_config_path("");
+	char *path = obs_module_config_path("incidents.bin");
+	if (dir)
+		os_mkdirs(dir);
+	g_open = path && incident_log_open(&g_log, path);
+	if (!g_open)
+		blog(LOG_WARNING, "[online-status] Incident log unavailable (%s)", path ? path : "no config path");
+	bfree(dir);
+	bfree(path);
+}
+
+void online_status_incidents_close(void)
+{
+	if (!g_open)
+		return;
+	// Sources are gone by now; nothing ticks any more
+	for (PolicyIncidents &p : g_policies)
+		incident_tracker_end(&p.tracker, &g_log);
+	incident_log_close(&g_log);
+	g_open = false;
+}
+
+IncidentLog *online_status_incidents_log(void)
+{
+	return g_open ? &g_log : nullptr;
+}
+
+// ------------------------ Per-output tracking ------------------------
+// Kind the output's record follows: reconnects take precedence, like on screen
+static int policy_kind(const PolicyIncidents &p)
+{
+	if (p.votes[INCIDENT_RECONNECTING].load(std::memory_order_relaxed))
+		return INCIDENT_RECONNECTING;
+	if (p.votes[INCIDENT_DROPPING].load(std::memory_order_relaxed))
+		return INCIDENT_DROPPING;
+	return -1;
+}
+
+static void move_vote(IncidentVote *vote, int policy, int kind)
+{
+	if (vote->policy >= 0 && vote->kind >= 0)
+		g_policies[vote->policy].votes[vote->kind].fetch_sub(1, std::memory_order_relaxed);
+	if (policy >= 0 && kind >= 0)
+		g_policies[policy].votes[kind].fetch_add(1, std::memory_order_relaxed);
+	vote->policy = policy;
+	vote->kind = kind;
+}
+
+// Graphics thread: close the record of a policy nobody shows an episode of any more
+static void settle(int policy)
+{
+	PolicyIncidents &p = g_policies[policy];
+	if (p.tracker.seq && policy_kind(p) < 0)
+		incident_tracker_end(&p.tracker, &g_log);
+}
+
+void online_status_incidents_tick(IncidentVote *vote, int policy, const DropDetector *d, const DropSample *sample,
+				  const char *output, const char *source)
+{
+	if (!g_open || policy < 0 || policy >= OUTPUT_POLICY_COUNT)
+		return;
+	if (g_unsettled.load(std::memory_order_relaxed) && g_unsettled.exchange(false, std::memory_order_acquire)) {
+		for (int p = 0; p < OUTPUT_POLICY_COUNT; p++)
+			settle(p);
+	}
+	const int kind = incident_kind(d);
+	if (kind < 0 && vote->kind < 0)
+		return;
+
+	const int prev_policy = vote->policy;
+	move_vote(vote, policy, kind);
+	if (prev_policy >= 0 && prev_policy != policy)
+		settle(prev_policy);
+
+	PolicyIncidents &p = g_policies[policy];
+	incident_tracker_tick(&p.tracker, &g_log, policy_kind(p), d, sample, output, source);
+}
+
+void online_status_incidents_leave(IncidentVote *vote)
+{
+	if (vote->kind < 0)
+		return;
+	move_vote(vote, -1, -1);
+	g_unsettled.store(true, std::memory_order_release);
+}
+
+uint64_t online_status_incidents_seq(int policy)
+{
+	if (policy < 0 || policy >= OUTPUT_POLICY_COUNT)
+		return 0;
+	return g_policies[policy].tracker.seq;
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "core/incident_log.hpp"
+
+// Module-wide incident log (incidents.bin in the plugin config directory), shared by every
+// Online Status source. Ticks write through the mapping; the file is opened and closed with
+// the module so the graphics thread never opens files.
+void online_status_incidents_open(void);
+void online_status_incidents_close(void);
+
+// nullptr when the log could not be opened
+IncidentLog *online_status_incidents_log(void);
+
+// Episodes are tracked once per watched output (OutputPolicy), however many sources watch
+// it: a record stays open while any of them shows the episode. A source's part in that:
+struct IncidentVote {
+	int policy = -1; // policy the source last reported on
+	int kind = -1;   // IncidentKind it showed there, -1 = none
+};
+
+// Graphics thread, after the source's detector ticked with this sample. Lock-free; sources
+// that show no episode and did not show one before return after a few loads.
+void online_status_incidents_tick(IncidentVote *vote, int policy, const DropDetector *d, const DropSample *sample,
+				  const char *output, const char *source);
+
+// Source going away (any thread): withdraw its vote; the next tick of any source closes the
+// record if it was the last one showing it
+void online_status_incidents_leave(IncidentVote *vote);
+
+// Graphics thread: record of the policy's open episode, 0 if none
+uint64_t online_status_incidents_seq(int policy);
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_link.hpp"
+#include "online_status.hpp"
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+static std::mutex g_mutex; // g_groups and every group's members
+static std::map<std::string, std::weak_ptr<LinkGroup>> g_groups;
+
+// Last snapshot naming the group is gone; nothing can reach the engine any more
+LinkGroup::~LinkGroup()
+{
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		auto it = g_groups.find(id);
+		if (it != g_groups.end() && it->second.expired())
+			g_groups.erase(it);
+	}
+	online_status_destroy(engine);
+}
+
+static void leave(OnlineStatus *member, LinkGroup *group)
+{
+	auto &members = group->members;
+	members.erase(std::remove(members.begin(), members.end(), member), members.end());
+	if (group->driver.load(std::memory_order_relaxed) == member) {
+		// Any member for now; a live one takes over with its next tick
+		group->driver.store(members.empty() ? nullptr : members.front(), std::memory_order_relaxed);
+		group->driver_live.store(false, std::memory_order_relaxed);
+	}
+}
+
+std::shared_ptr<LinkGroup> online_status_link_join(OnlineStatus *member, const std::shared_ptr<LinkGroup> &current,
+						   const char *id)
+{
+	const std::string want = id ? id : "";
+	if (current && current->id == want)
+		return current;
+
+	std::lock_guard<std::mutex> lock(g_mutex);
+	if (current)
+		leave(member, current.get());
+	if (want.empty())
+		return nullptr;
+
+	std::shared_ptr<LinkGroup> group = g_groups[want].lock();
+	if (!group) {
+		group = std::make_shared<LinkGroup>();
+		group->id = want;
+		group->engine = new OnlineStatus();
+		// The engine runs the group's detector, so it records and exports the group's state
+		const std::string label = "link " + want;
+		group->engine->metrics = online_status_metrics_register(label.c_str());
+		group->engine->status = online_status_shm_register(label.c_str());
+		group->engine->recorder = online_status_recorder_register(label.c_str());
+		g_groups[want] = group;
+	}
+	group->members.push_back(member);
+	if (!group->driver.load(std::memory_order_relaxed))
+		group->driver.store(member, std::memory_order_relaxed);
+	return group;
+}
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Linked groups: Online Status sources with the same group id show one shared overlay. The
+// group owns a hidden OnlineStatus (the engine) with the only detector, children and
+// textures; members publish the group in their config snapshot, so the engine lives for as
+// long as any graphics-thread reader may still reach it. One member (the driver) ticks the
+// engine each frame and plays the group's sounds; a member with sound in the program scene
+// takes that over from one that is not, so sounds reach the mix. Every member draws its render plan.
+struct OnlineStatus;
+
+struct LinkGroup {
+	std::string id;
+	OnlineStatus *engine = nullptr;              // settings of the member edited last
+	std::vector<OnlineStatus *> members;         // registry mutex
+	std::atomic<OnlineStatus *> driver{nullptr}; // member whose tick ticks the engine
+	std::atomic<bool> driver_live{false};         // the driver has sound and is in the program scene
+
+	~LinkGroup(); // destroys the engine
+};
+
+// UI thread: move member from current into the group id ("" or nullptr: no group). Returns
+// the group it belongs to now; a new group's engine has no settings yet.
+std::shared_ptr<LinkGroup> online_status_link_join(OnlineStatus *member, const std::shared_ptr<LinkGroup> &current,
+						   const char *id);
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_loader.hpp"
+#include <util/platform.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct PeriodicJob {
+	std::chrono::milliseconds interval;
+	Clock::time_point next;
+	std::function<void()> job;
+};
+
+static std::thread g_thread;
+static std::mutex g_mutex;
+static std::condition_variable g_wake;
+static std::deque<std::function<void()>> g_jobs;
+static std::vector<PeriodicJob> g_periodic;
+static bool g_stop = false;
+
+// g_mutex held: the periodic job due first, nullptr if there is none
+static PeriodicJob *next_periodic(void)
+{
+	PeriodicJob *first = nullptr;
+	for (PeriodicJob &p : g_periodic) {
+		if (!first || p.next < first->next)
+			first = &p;
+	}
+	return first;
+}
+
+static void loader_thread(void)
+{
+	os_set_thread_name("online-status: loader");
+
+	std::unique_lock<std::mutex> lock(g_mutex);
+	for (;;) {
+		const auto ready = [] { return g_stop || !g_jobs.empty(); };
+		if (const PeriodicJob *periodic = next_periodic()) {
+			const Clock::time_point due = periodic->next; // the vector may grow while waiting
+			g_wake.wait_until(lock, due, ready);
+		} else {
+			g_wake.wait(lock, ready);
+		}
+		if (g_stop)
+			return;
+
+		std::function<void()> job;
+		if (!g_jobs.empty()) {
+			job = std::move(g_jobs.front());
+			g_jobs.pop_front();
+		} else {
+			PeriodicJob *periodic = next_periodic();
+			if (!periodic || Clock::now() < periodic->next)
+				continue;
+			periodic->next = Clock::now() + periodic->interval;
+			job = periodic->job;
+		}
+
+		lock.unlock();
+		job();
+		lock.lock();
+	}
+}
+
+void online_status_loader_submit(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		if (g_stop)
+			return;
+		g_jobs.push_back(std::move(job));
+		if (!g_thread.joinable())
+			g_thread = std::thread(loader_thread);
+	}
+	g_wake.notify_one();
+}
+
+void online_status_loader_every(uint32_t interval_ms, std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		if (g_stop)
+			return;
+		const auto interval = std::chrono::milliseconds(interval_ms);
+		g_periodic.push_back(PeriodicJob{interval, Clock::now() + interval, std::move(job)});
+	}
+	g_wake.notify_one();
+}
+
+void online_status_loader_stop(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		g_stop = true;
+	}
+	g_wake.notify_all();
+	if (g_thread.joinable())
+		g_thread.join();
+
+	// Dropped jobs own nothing that outlives the module; their owners were destroyed already
+	std::lock_guard<std::mutex> lock(g_mutex);
+	g_jobs.clear();
+	g_periodic.clear();
+}
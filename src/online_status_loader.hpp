@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+
+// One background thread for slow, thread-safe libobs work (creating image children,
+// decoding files) so neither the UI nor the graphics thread waits on the disk.
+// Jobs run in submission order; the thread starts with the first job.
+void online_status_loader_submit(std::function<void()> job);
+
+// Also run job on the loader thread every interval_ms, between the submitted jobs, while
+// the thread runs (housekeeping the graphics thread must not do itself)
+void online_status_loader_every(uint32_t interval_ms, std::function<void()> job);
+
+// obs_module_unload: let the running job finish and drop the queued ones
+void online_status_loader_stop(void);
@@ -0,0 +1,527 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_metrics.hpp"
+#include <obs-module.h>
+#include <util/platform.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/*
+    Ticks only bump relaxed atomics in their own SourceMetrics block. The exporter thread
+    exists while an export target is configured; it takes the registry lock, formats every
+    block into one text buffer and writes it out, so the graphics thread never formats,
+    allocates or waits on I/O for metrics.
+*/
+
+static constexpr uint32_t kFileIntervalMs = 5000; // file rewrite period
+static constexpr int kSocketPollMs = 250;         // how often the socket loop checks for stop
+
+// Overlay state a source is in; every tick adds its duration to one of them
+enum MetricsState {
+	STATE_IDLE = 0, // not streaming
+	STATE_OK,       // streaming, nothing shown
+	STATE_DROPPING,
+	STATE_DEGRADING,
+	STATE_RECONNECTING,
+	STATE_STABLE,
+	STATE_COUNT
+};
+
+// Alerts that form episodes (stable is the end of one, not an alert)
+enum MetricsAlert {
+	ALERT_DROPPING = 0,
+	ALERT_DEGRADING,
+	ALERT_RECONNECTING,
+	ALERT_COUNT,
+	ALERT_NONE = ALERT_COUNT
+};
+
+static const char *const kStateNames[STATE_COUNT] = {"idle",      "ok",           "dropping",
+						     "degrading", "reconnecting", "stable"};
+static const char *const kAlertNames[ALERT_COUNT] = {"dropping", "degrading", "reconnecting"};
+static const char *const kCauseNames[DROP_CAUSE_COUNT] = {"network", "encoder", "render"};
+
+// Upper bounds of the tick duration histogram; one more bucket counts the rest (+Inf)
+static const uint64_t kTickBucketsNs[] = {1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000};
+static constexpr size_t kTickBucketCount = sizeof(kTickBucketsNs) / sizeof(kTickBucketsNs[0]);
+
+struct SourceMetrics {
+	std::string name; // g_sources_mutex
+
+	// Written by the graphics thread, read by the exporter
+	std::atomic<uint64_t> state_ns[STATE_COUNT];
+	std::atomic<uint64_t> episodes[ALERT_COUNT];       // started
+	std::atomic<uint64_t> episodes_ended[ALERT_COUNT]; // finished, counted in episode_ns
+	std::atomic<uint64_t> episode_ns[ALERT_COUNT];
+	std::atomic<float> drop_pct[DROP_CAUSE_COUNT]; // windowed drop % the detector compares
+	std::atomic<uint64_t> tick_buckets[kTickBucketCount + 1];
+	std::atomic<uint64_t> tick_ns_sum{0};
+	std::atomic<uint64_t> ticks{0};
+	std::atomic<bool> hidden{false}; // linked: the group is reported under its own name
+
+	// Graphics thread only
+	int alert = ALERT_NONE;
+	uint64_t alert_ns = 0; // length of the running episode
+};
+
+static std::mutex g_sources_mutex;
+static std::vector<SourceMetrics *> g_sources;
+
+static std::mutex g_config_mutex; // configuration and exporter thread lifetime
+static int g_mode = METRICS_EXPORT_OFF;
+static std::string g_path;
+static std::atomic<bool> g_enabled{false};
+
+static std::thread g_thread;
+static std::mutex g_wake_mutex;
+static std::condition_variable g_wake;
+static std::atomic<bool> g_stop{false};
+
+// ------------------------ Graphics thread ------------------------
+static inline void add(std::atomic<uint64_t> &counter, uint64_t value)
+{
+	counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+void online_status_metrics_tick(SourceMetrics *m, const DropDetector *det, const DropDetectorConfig *cfg,
+				bool streaming, float seconds, uint64_t tick_ns)
+{
+	if (!m)
+		return;
+	m->hidden.store(false, std::memory_order_relaxed);
+	const uint64_t dt_ns = seconds > 0.0f ? (uint64_t)((double)seconds * 1e9) : 0;
+
+	int state;
+	int alert = ALERT_NONE;
+	if (cfg && drop_detector_reconnecting_on(det, cfg)) {
+		state = STATE_RECONNECTING;
+		alert = ALERT_RECONNECTING;
+	} else if (det->auto_visible) {
+		state = STATE_DROPPING;
+		alert = ALERT_DROPPING;
+	} else if (det->degrading_visible) {
+		state = STATE_DEGRADING;
+		alert = ALERT_DEGRADING;
+	} else if (det->stable_visible) {
+		state = STATE_STABLE;
+	} else {
+		state = streaming ? STATE_OK : STATE_IDLE;
+	}
+	add(m->state_ns[state], dt_ns);
+
+	// Episodes: one per stretch of the same alert
+	if (alert != m->alert) {
+		if (m->alert != ALERT_NONE) {
+			add(m->episode_ns[m->alert], m->alert_ns);
+			add(m->episodes_ended[m->alert], 1);
+		}
+		if (alert != ALERT_NONE)
+			add(m->episodes[alert], 1);
+		m->alert = alert;
+		m->alert_ns = 0;
+	}
+	if (alert != ALERT_NONE)
+		m->alert_ns += dt_ns;
+
+	for (int c = 0; c < DROP_CAUSE_COUNT; c++)
+		m->drop_pct[c].store((float)det->signals[c].pct, std::memory_order_relaxed);
+
+	size_t bucket = 0;
+	while (bucket < kTickBucketCount && tick_ns > kTickBucketsNs[bucket])
+		bucket++;
+	add(m->tick_buckets[bucket], 1);
+	add(m->tick_ns_sum, tick_ns);
+	add(m->ticks, 1);
+}
+
+void online_status_metrics_hide(SourceMetrics *m)
+{
+	if (m)
+		m->hidden.store(true, std::memory_order_relaxed);
+}
+
+bool online_status_metrics_enabled(void)
+{
+	return g_enabled.load(std::memory_order_relaxed);
+}
+
+// ------------------------ Registry ------------------------
+SourceMetrics *online_status_metrics_register(const char *name)
+{
+	auto *m = new SourceMetrics();
+	m->name = name ? name : "";
+	std::lock_guard<std::mutex> lock(g_sources_mutex);
+	g_sources.push_back(m);
+	return m;
+}
+
+void online_status_metrics_unregister(SourceMetrics *m)
+{
+	if (!m)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(g_sources_mutex);
+		g_sources.erase(std::remove(g_sources.begin(), g_sources.end(), m), g_sources.end());
+	}
+	delete m;
+}
+
+void online_status_metrics_rename(SourceMetrics *m, const char *name)
+{
+	if (!m)
+		return;
+	std::lock_guard<std::mutex> lock(g_sources_mutex);
+	m->name = name ? name : "";
+}
+
+// ------------------------ Text format (exporter thread) ------------------------
+static void append_header(std::string &out, const char *name, const char *type, const char *help)
+{
+	out += "# HELP ";
+	out += name;
+	out += ' ';
+	out += help;
+	out += "\n# TYPE ";
+	out += name;
+	out += ' ';
+	out += type;
+	out += '\n';
+}
+
+// Label values escape backslash, quote and newline
+static void append_label(std::string &out, const char *key, const std::string &value)
+{
+	out += key;
+	out += "=\"";
+	for (char ch : value) {
+		if (ch == '\\' || ch == '"')
+			out += '\\';
+		if (ch == '\n') {
+			out += "\\n";
+			continue;
+		}
+		out += ch;
+	}
+	out += '"';
+}
+
+static void append_sample(std::string &out, const char *name, const std::string &source, const char *key,
+			  const char *value, double number)
+{
+	char buf[64];
+	out += name;
+	out += '{';
+	append_label(out, "source", source);
+	if (key) {
+		out += ',';
+		append_label(out, key, value);
+	}
+	snprintf(buf, sizeof(buf), "} %.9g\n", number);
+	out += buf;
+}
+
+static inline double load_sec(const std::atomic<uint64_t> &ns)
+{
+	return (double)ns.load(std::memory_order_relaxed) / 1e9;
+}
+
+static inline double load_count(const std::atomic<uint64_t> &n)
+{
+	return (double)n.load(std::memory_order_relaxed);
+}
+
+static void serialize_sources(std::string &out)
+{
+	std::lock_guard<std::mutex> lock(g_sources_mutex);
+	std::vector<const SourceMetrics *> sources;
+	for (const SourceMetrics *m : g_sources) {
+		if (!m->hidden.load(std::memory_order_relaxed))
+			sources.push_back(m);
+	}
+
+	append_header(out, "online_status_state_seconds_total", "counter", "Time spent in each overlay state.");
+	for (const SourceMetrics *m : sources)
+		for (int i = 0; i < STATE_COUNT; i++)
+			append_sample(out, "online_status_state_seconds_total", m->name, "state", kStateNames[i],
+				      load_sec(m->state_ns[i]));
+
+	append_header(out, "online_status_alert_episodes_total", "counter", "Alert episodes started.");
+	for (const SourceMetrics *m : sources)
+		for (int i = 0; i < ALERT_COUNT; i++)
+			append_sample(out, "online_status_alert_episodes_total", m->name, "alert", kAlertNames[i],
+				      load_count(m->episodes[i]));
+
+	append_header(out, "online_status_alert_episode_seconds", "summary", "Length of finished alert episodes.");
+	for (const SourceMetrics *m : sources) {
+		for (int i = 0; i < ALERT_COUNT; i++) {
+			append_sample(out, "online_status_alert_episode_seconds_sum", m->name, "alert",
+				      kAlertNames[i], load_sec(m->episode_ns[i]));
+			append_sample(out, "online_status_alert_episode_seconds_count", m->name, "alert",
+				      kAlertNames[i], load_count(m->episodes_ended[i]));
+		}
+	}
+
+	append_header(out, "online_status_drop_percent", "gauge", "Windowed drop % of each watched signal.");
+	for (const SourceMetrics *m : sources)
+		for (int c = 0; c < DROP_CAUSE_COUNT; c++)
+			append_sample(out, "online_status_drop_percent", m->name, "cause", kCauseNames[c],
+				      (double)m->drop_pct[c].load(std::memory_order_relaxed));
+
+	append_header(out, "online_status_tick_duration_seconds", "histogram", "Cost of video_tick.");
+	for (const SourceMetrics *m : sources) {
+		uint64_t cumulative = 0;
+		char le[32];
+		for (size_t b = 0; b <= kTickBucketCount; b++) {
+			cumulative += m->tick_buckets[b].load(std::memory_order_relaxed);
+			if (b < kTickBucketCount)
+				snprintf(le, sizeof(le), "%g", (double)kTickBucketsNs[b] / 1e9);
+			else
+				snprintf(le, sizeof(le), "+Inf");
+			append_sample(out, "online_status_tick_duration_seconds_bucket", m->name, "le", le,
+				      (double)cumulative);
+		}
+		append_sample(out, "online_status_tick_duration_seconds_sum", m->name, nullptr, nullptr,
+			      load_sec(m->tick_ns_sum));
+		append_sample(out, "online_status_tick_duration_seconds_count", m->name, nullptr, nullptr,
+			      load_count(m->ticks));
+	}
+}
+
+// Cumulative counters of every active output, straight from libobs
+struct OutputSample {
+	std::string name;
+	uint64_t total;
+	uint64_t dropped;
+};
+
+static bool enum_output(void *param, obs_output_t *output)
+{
+	if (!obs_output_active(output))
+		return true;
+	auto *outputs = static_cast<std::vector<OutputSample> *>(param);
+	const char *name = obs_output_get_name(output);
+	outputs->push_back({name ? name : "", (uint64_t)obs_output_get_total_frames(output),
+			    (uint64_t)obs_output_get_frames_dropped(output)});
+	return true;
+}
+
+static void append_output(std::string &out, const char *name, const std::string &output, double number)
+{
+	char buf[64];
+	out += name;
+	out += '{';
+	append_label(out, "output", output);
+	snprintf(buf, sizeof(buf), "} %.9g\n", number);
+	out += buf;
+}
+
+static void serialize_outputs(std::string &out)
+{
+	std::vector<OutputSample> outputs;
+	obs_enum_outputs(enum_output, &outputs);
+
+	append_header(out, "online_status_output_drop_percent", "gauge", "Dropped frames of an active output, %.");
+	for (const OutputSample &o : outputs)
+		append_output(out, "online_status_output_drop_percent", o.name,
+			      o.total ? (double)o.dropped * 100.0 / (double)o.total : 0.0);
+	append_header(out, "online_status_output_frames_total", "counter", "Frames sent by an active output.");
+	for (const OutputSample &o : outputs)
+		append_output(out, "online_status_output_frames_total", o.name, (double)o.total);
+	append_header(out, "online_status_output_frames_dropped_total", "counter",
+		      "Frames dropped by an active output.");
+	for (const OutputSample &o : outputs)
+		append_output(out, "online_status_output_frames_dropped_total", o.name, (double)o.dropped);
+}
+
+static std::string serialize(void)
+{
+	std::string out;
+	out.reserve(4096);
+	serialize_sources(out);
+	serialize_outputs(out);
+	return out;
+}
+
+// ------------------------ Exporter thread ------------------------
+static void export_file(const std::string &path)
+{
+	std::unique_lock<std::mutex> lock(g_wake_mutex);
+	while (!g_stop.load(std::memory_order_relaxed)) {
+		lock.unlock();
+		const std::string text = serialize();
+		// Written next to the target and renamed, so readers never see half a file
+		if (!os_quick_write_utf8_file_safe(path.c_str(), text.data(), text.size(), false, "tmp", nullptr))
+			blog(LOG_WARNING, "[online-status] Failed to write metrics to '%s'", path.c_str());
+		lock.lock();
+		g_wake.wait_for(lock, std::chrono::milliseconds(kFileIntervalMs),
+				[] { return g_stop.load(std::memory_order_relaxed); });
+	}
+}
+
+#ifndef _WIN32
+// Identity of the socket file this process bound, so exit never removes anything else
+struct SocketFile {
+	dev_t dev = 0;
+	ino_t ino = 0;
+};
+
+static int open_socket(const std::string &path, SocketFile *bound)
+{
+	sockaddr_un addr = {};
+	addr.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(addr.sun_path)) {
+		blog(LOG_WARNING, "[online-status] Metrics socket path too long: '%s'", path.c_str());
+		return -1;
+	}
+	memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+	// A socket left behind by a previous run would make bind fail; anything else at the
+	// path (e.g. the metrics file of the File mode) is the user's and stays
+	struct stat st;
+	if (lstat(path.c_str(), &st) == 0) {
+		if (!S_ISSOCK(st.st_mode)) {
+			blog(LOG_WARNING, "[online-status] '%s' exists and is not a socket; not exporting metrics there",
+			     path.c_str());
+			return -1;
+		}
+		unlink(path.c_str());
+	}
+
+	const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0)
+		return -1;
+	if (bind(fd, (const sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 4) != 0 ||
+	    lstat(path.c_str(), &st) != 0) {
+		blog(LOG_WARNING, "[online-status] Failed to listen on metrics socket '%s'", path.c_str());
+		close(fd);
+		return -1;
+	}
+	bound->dev = st.st_dev;
+	bound->ino = st.st_ino;
+	return fd;
+}
+
+// Plain HTTP so `curl --unix-socket <path> http://localhost/metrics` works; the request is
+// read once and otherwise ignored
+static void serve_client(int client)
+{
+	const timeval timeout = {0, 200000};
+	setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	char request[1024];
+	(void)recv(client, request, sizeof(request), 0);
+
+	const std::string body = serialize();
+	char head[128];
+	const int head_len = snprintf(head, sizeof(head),
+				      "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+				      "Content-Length: %zu\r\n\r\n",
+				      body.size());
+	std::string response(head, (size_t)head_len);
+	response += body;
+	for (size_t sent = 0; sent < response.size();) {
+		const ssize_t n = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+		if (n <= 0)
+			break;
+		sent += (size_t)n;
+	}
+}
+
+static void export_socket(const std::string &path)
+{
+	SocketFile bound;
+	const int fd = open_socket(path, &bound);
+	if (fd < 0)
+		return;
+	while (!g_stop.load(std::memory_order_relaxed)) {
+		pollfd pfd = {fd, POLLIN, 0};
+		if (poll(&pfd, 1, kSocketPollMs) <= 0)
+			continue;
+		const int client = accept(fd, nullptr, nullptr);
+		if (client < 0)
+			continue;
+		serve_client(client);
+		close(client);
+	}
+	close(fd);
+	// Only if nobody replaced it meanwhile
+	struct stat st;
+	if (lstat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode) && st.st_dev == bound.dev && st.st_ino == bound.ino)
+		unlink(path.c_str());
+}
+#endif
+
+static void exporter_thread(int mode, std::string path)
+{
+	os_set_thread_name("online-status: metrics");
+	if (mode == METRICS_EXPORT_FILE)
+		export_file(path);
+#ifndef _WIN32
+	else if (mode == METRICS_EXPORT_SOCKET)
+		export_socket(path);
+#endif
+}
+
+// g_config_mutex held
+static void stop_thread_locked(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(g_wake_mutex);
+		g_stop.store(true, std::memory_order_relaxed);
+	}
+	g_wake.notify_all();
+	if (g_thread.joinable())
+		g_thread.join();
+	g_enabled.store(false, std::memory_order_relaxed);
+}
+
+// ------------------------ Lifetime ------------------------
+void online_status_metrics_configure(int mode, const char *path)
+{
+	if (!path || !*path || mode < METRICS_EXPORT_OFF || mode > METRICS_EXPORT_SOCKET)
+		mode = METRICS_EXPORT_OFF;
+#ifdef _WIN32
+	if (mode == METRICS_EXPORT_SOCKET) {
+		blog(LOG_WARNING, "[online-status] Metrics socket is not supported on Windows; use a file");
+		mode = METRICS_EXPORT_OFF;
+	}
+#endif
+	const std::string target = mode != METRICS_EXPORT_OFF ? path : "";
+
+	std::lock_guard<std::mutex> lock(g_config_mutex);
+	if (mode == g_mode && target == g_path)
+		return;
+	stop_thread_locked();
+	g_mode = mode;
+	g_path = target;
+	if (mode == METRICS_EXPORT_OFF)
+		return;
+
+	g_stop.store(false, std::memory_order_relaxed);
+	g_enabled.store(true, std::memory_order_relaxed);
+	g_thread = std::thread(exporter_thread, mode, target);
+	blog(LOG_INFO, "[online-status] Exporting metrics to %s '%s'", mode == METRICS_EXPORT_FILE ? "file" : "socket",
+	     target.c_str());
+}
+
+void online_status_metrics_stop(void)
+{
+	std::lock_guard<std::mutex> lock(g_config_mutex);
+	stop_thread_locked();
+	g_mode = METRICS_EXPORT_OFF;
+	g_path.clear();
+}
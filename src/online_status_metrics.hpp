@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include "core/drop_detector.hpp"
+
+// Optional Prometheus text-format exporter. Every source owns a block of counters that its
+// video_tick updates with relaxed atomics (no allocation, no locks); a module-level thread
+// serializes all blocks, plus the cumulative drop % of every active output, either into a
+// file that is rewritten periodically or for each client of a unix domain socket.
+struct SourceMetrics;
+
+// Values of the metrics_export setting
+enum MetricsExport {
+	METRICS_EXPORT_OFF = 0,
+	METRICS_EXPORT_FILE = 1,   // rewrite the file every few seconds (textfile collectors)
+	METRICS_EXPORT_SOCKET = 2, // answer each connection with an HTTP/1.0 response (not on Windows)
+};
+
+// UI thread: per-source block, labelled with the source name
+SourceMetrics *online_status_metrics_register(const char *name);
+void online_status_metrics_unregister(SourceMetrics *metrics);
+void online_status_metrics_rename(SourceMetrics *metrics, const char *name);
+
+// Exporter mode and target, shared by every Online Status source; the last edited source wins
+void online_status_metrics_configure(int mode, const char *path);
+
+// Cheap check so ticks skip the clock reads while nothing is exported
+bool online_status_metrics_enabled(void);
+
+// Graphics thread, after the detector ticked: state time, alert episodes, drop % and tick cost
+void online_status_metrics_tick(SourceMetrics *metrics, const DropDetector *det, const DropDetectorConfig *cfg,
+				bool streaming, float seconds, uint64_t tick_ns);
+
+// Graphics thread: leave the source out of the export until its next metrics tick (a linked
+// member; its group is exported once, under the group's name)
+void online_status_metrics_hide(SourceMetrics *metrics);
+
+// obs_module_unload
+void online_status_metrics_stop(void);
@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #include "online_status.hpp"
+#include "online_status_sampler.hpp"
+#include <util/bmem.h>
 
 // Property UI visibility refresher (C-callable for OBS callbacks)
 static bool online_status_properties_refresh(obs_properties_t *props, obs_property_t * /*property*/,
@@ -17,80 +19,234 @@ static bool online_status_properties_refresh(obs_properties_t *props, obs_proper
 	if (obs_property_t *grp = obs_properties_get(props, "dropping_group")) {
 		obs_properties_t *inner = obs_property_group_content(grp);
 		if (inner) {
-			bool show_drop = (section == 0);
+			bool show_drop = (section == SECTION_DROPPING);
 			if (obs_property_t *pp = obs_properties_get(inner, "content_mode"))
 				obs_property_set_visible(pp, show_drop);
 			if (obs_property_t *pp = obs_properties_get(inner, "status_text"))
 				obs_property_set_visible(pp, show_drop && mode_val == 0);
 			if (obs_property_t *pp = obs_properties_get(inner, "image_path"))
-				obs_property_set_visible(pp, show_drop && mode_val == 1);
+				obs_property_set_visible(pp, show_drop && (mode_val == CONTENT_IMAGE ||
+									    mode_val == CONTENT_SPRITE));
+			if (obs_property_t *pp = obs_properties_get(inner, "output_policy"))
+				obs_property_set_visible(pp, show_drop);
 			if (obs_property_t *pp = obs_properties_get(inner, "drop_threshold_pct"))
 				obs_property_set_visible(pp, show_drop);
+			if (obs_property_t *pp = obs_properties_get(inner, "drop_exit_threshold_pct"))
+				obs_property_set_visible(pp, show_drop);
+			if (obs_property_t *pp = obs_properties_get(inner, "drop_window_ms"))
+				obs_property_set_visible(pp, show_drop);
+			const bool adaptive = obs_data_get_int(settings, "drop_threshold_mode") == THRESHOLD_ADAPTIVE;
+			if (obs_property_t *pp = obs_properties_get(inner, "drop_threshold_mode"))
+				obs_property_set_visible(pp, show_drop);
+			if (obs_property_t *pp = obs_properties_get(inner, "adaptive_quantile"))
+				obs_property_set_visible(pp, show_drop && adaptive);
+			if (obs_property_t *pp = obs_properties_get(inner, "adaptive_learn_sec"))
+				obs_property_set_visible(pp, show_drop && adaptive);
+			if (obs_property_t *pp = obs_properties_get(inner, "adaptive_min_pct"))
+				obs_property_set_visible(pp, show_drop && adaptive);
 			if (obs_property_t *pp = obs_properties_get(inner, "hide_after_sec"))
 				obs_property_set_visible(pp, show_drop);
-			if (obs_property_t *pp = obs_properties_get(inner, "drop_blink_enabled"))
+			int anim = (int)obs_data_get_int(settings, "drop_anim");
+			if (obs_property_t *pp = obs_properties_get(inner, "drop_anim"))
 				obs_property_set_visible(pp, show_drop);
+			if (obs_property_t *pp = obs_properties_get(inner, "drop_anim_easing"))
+				obs_property_set_visible(pp, show_drop && anim > ANIM_BLINK);
 			if (obs_property_t *pp = obs_properties_get(inner, "drop_blink_rate_hz"))
+				obs_property_set_visible(pp, show_drop && anim != ANIM_NONE);
+			if (obs_property_t *pp = obs_properties_get(inner, "drop_sound"))
 				obs_property_set_visible(pp, show_drop);
 		}
 	}
 
+	// Causes group inner properties
+	if (obs_property_t *grp = obs_properties_get(props, "cause_group")) {
+		obs_properties_t *inner = obs_property_group_content(grp);
+		if (inner) {
+			bool show_causes = (section == SECTION_CAUSES);
+			bool enc_on = obs_data_get_bool(settings, "watch_encoder");
+			bool ren_on = obs_data_get_bool(settings, "watch_render");
+			int enc_mode = (int)obs_data_get_int(settings, "encoder_mode");
+			int ren_mode = (int)obs_data_get_int(settings, "render_mode");
+
+			if (obs_property_t *pp = obs_properties_get(inner, "watch_network"))
+				obs_property_set_visible(pp, show_causes);
+			if (obs_property_t *pp = obs_properties_get(inner, "watch_encoder"))
+				obs_property_set_visible(pp, show_causes);
+			if (obs_property_t *pp = obs_properties_get(inner, "encoder_mode"))
+				obs_property_set_visible(pp, show_causes && enc_on);
+			if (obs_property_t *pp = obs_properties_get(inner, "encoder_text"))
+				obs_property_set_visible(pp, show_causes && enc_on && enc_mode == CONTENT_TEXT);
+			if (obs_property_t *pp = obs_properties_get(inner, "encoder_image_path"))
+				obs_property_set_visible(pp, show_causes && enc_on && enc_mode == CONTENT_IMAGE);
+			if (obs_property_t *pp = obs_properties_get(inner, "watch_render"))
+				obs_property_set_visible(pp, show_causes);
+			if (obs_property_t *pp = obs_properties_get(inner, "render_mode"))
+				obs_property_set_visible(pp, show_causes && ren_on);
+			if (obs_property_t *pp = obs_properties_get(inner, "render_text"))
+				obs_property_set_visible(pp, show_causes && ren_on && ren_mode == CONTENT_TEXT);
+			if (obs_property_t *pp = obs_properties_get(inner, "render_image_path"))
+				obs_property_set_visible(pp, show_causes && ren_on && ren_mode == CONTENT_IMAGE);
+		}
+	}
+
+	// Early warning group inner properties
+	if (obs_property_t *grp = obs_properties_get(props, "degrade_group")) {
+		obs_properties_t *inner = obs_property_group_content(grp);
+		if (inner) {
+			bool show_warn = (section == SECTION_EARLY_WARNING);
+			bool warn_on = show_warn && obs_data_get_bool(settings, "degrade_enabled");
+			int warn_mode = (int)obs_data_get_int(settings, "degrade_mode");
+
+			if (obs_property_t *pp = obs_properties_get(inner, "degrade_enabled"))
+				obs_property_set_visible(pp, show_warn);
+			if (obs_property_t *pp = obs_properties_get(inner, "degrade_congestion_pct"))
+				obs_property_set_visible(pp, warn_on);
+			if (obs_property_t *pp = obs_properties_get(inner, "degrade_slope_pct"))
+				obs_property_set_visible(pp, warn_on);
+			if (obs_property_t *pp = obs_properties_get(inner, "degrade_bitrate_drop_pct"))
+				obs_property_set_visible(pp, warn_on);
+			if (obs_property_t *pp = obs_properties_get(inner, "degrade_mode"))
+				obs_property_set_visible(pp, warn_on);
+			if (obs_property_t *pp = obs_properties_get(inner, "degrade_text"))
+				obs_property_set_visible(pp, warn_on && warn_mode == CONTENT_TEXT);
+			if (obs_property_t *pp = obs_properties_get(inner, "degrade_image_path"))
+				obs_property_set_visible(pp, warn_on && warn_mode == CONTENT_IMAGE);
+		}
+	}
+
+	// Reconnecting group inner properties
+	if (obs_property_t *grp = obs_properties_get(props, "reconnect_group")) {
+		obs_properties_t *inner = obs_property_group_content(grp);
+		if (inner) {
+			bool show_rec = (section == SECTION_RECONNECTING);
+			bool rec_on = show_rec && obs_data_get_bool(settings, "reconnect_enabled");
+			int rec_mode = (int)obs_data_get_int(settings, "reconnect_mode");
+
+			if (obs_property_t *pp = obs_properties_get(inner, "reconnect_enabled"))
+				obs_property_set_visible(pp, show_rec);
+			if (obs_property_t *pp = obs_properties_get(inner, "reconnect_mode"))
+				obs_property_set_visible(pp, rec_on);
+			if (obs_property_t *pp = obs_properties_get(inner, "reconnect_text"))
+				obs_property_set_visible(pp, rec_on && rec_mode == CONTENT_TEXT);
+			if (obs_property_t *pp = obs_properties_get(inner, "reconnect_show_elapsed"))
+				obs_property_set_visible(pp, rec_on && rec_mode == CONTENT_TEXT);
+			if (obs_property_t *pp = obs_properties_get(inner, "reconnect_image_path"))
+				obs_property_set_visible(pp, rec_on && rec_mode == CONTENT_IMAGE);
+		}
+	}
+
 	// Stable group inner properties
 	if (obs_property_t *grp = obs_properties_get(props, "stable_group")) {
 		obs_properties_t *inner = obs_property_group_content(grp);
 		if (inner) {
 			bool s_enabled_v = obs_data_get_bool(settings, "stable_enabled");
 			int s_mode = (int)obs_data_get_int(settings, "stable_mode");
-			bool show_inner = (section == 1) && s_enabled_v;
+			bool show_inner = (section == SECTION_STABLE) && s_enabled_v;
 
 			if (obs_property_t *pp = obs_properties_get(inner, "stable_mode"))
-				obs_property_set_visible(pp, section == 1);
+				obs_property_set_visible(pp, section == SECTION_STABLE);
 			if (obs_property_t *pp = obs_properties_get(inner, "stable_text"))
 				obs_property_set_visible(pp, show_inner && s_mode == 0);
 			if (obs_property_t *pp = obs_properties_get(inner, "stable_image_path"))
-				obs_property_set_visible(pp, show_inner && s_mode == 1);
+				obs_property_set_visible(pp, show_inner && (s_mode == 1 || s_mode == CONTENT_SPRITE));
 			if (obs_property_t *pp = obs_properties_get(inner, "stable_enabled"))
-				obs_property_set_visible(pp, section == 1);
+				obs_property_set_visible(pp, section == SECTION_STABLE);
 			if (obs_property_t *pp = obs_properties_get(inner, "stable_duration_sec"))
-				obs_property_set_visible(pp, (section == 1) && s_enabled_v);
-			if (obs_property_t *pp = obs_properties_get(inner, "stable_blink_enabled"))
-				obs_property_set_visible(pp, (section == 1) && s_enabled_v);
+				obs_property_set_visible(pp, show_inner);
+			int s_anim = (int)obs_data_get_int(settings, "stable_anim");
+			if (obs_property_t *pp = obs_properties_get(inner, "stable_anim"))
+				obs_property_set_visible(pp, show_inner);
+			if (obs_property_t *pp = obs_properties_get(inner, "stable_anim_easing"))
+				obs_property_set_visible(pp, show_inner && s_anim > ANIM_BLINK);
 			if (obs_property_t *pp = obs_properties_get(inner, "stable_blink_rate_hz"))
-				obs_property_set_visible(pp, (section == 1) && s_enabled_v);
+				obs_property_set_visible(pp, show_inner && s_anim != ANIM_NONE);
+			if (obs_property_t *pp = obs_properties_get(inner, "stable_sound"))
+				obs_property_set_visible(pp, show_inner);
 		}
 	}
 
-	// Pseudo-tabs visibility (no separate Blink tab)
-	bool show_dropping = (section == 0);
-	bool show_stable = (section == 1);
-	bool show_adv = (section == 2);
+	// Pseudo-tabs visibility (no separate Animation tab)
+	bool show_dropping = (section == SECTION_DROPPING);
+	bool show_stable = (section == SECTION_STABLE);
+	bool show_adv = (section == SECTION_ADVANCED);
+	bool show_causes = (section == SECTION_CAUSES);
+	bool show_warn = (section == SECTION_EARLY_WARNING);
+	bool show_reconnect = (section == SECTION_RECONNECTING);
 
 	auto show_adv_field = [&](const char *name) {
 		set_vis(name, show_adv);
 	};
+	show_adv_field("link_group");
 	show_adv_field("visible");
 	show_adv_field("test_force_drop");
 	show_adv_field("test_simulate_spike");
 	show_adv_field("test_show_stable");
+	show_adv_field("test_show_degrading");
+	show_adv_field("test_show_reconnecting");
 	show_adv_field("test_hide_all");
+	show_adv_field("stats_interval_ms");
+	show_adv_field("render_cache");
+	const int stable_mode = (int)obs_data_get_int(settings, "stable_mode");
+	const bool graph_mode = mode_val == CONTENT_GRAPH || stable_mode == CONTENT_GRAPH;
+	set_vis("graph_seconds", show_adv && graph_mode);
+	const bool sprite_mode = mode_val == CONTENT_SPRITE || stable_mode == CONTENT_SPRITE;
+	set_vis("sprite_columns", show_adv && sprite_mode);
+	set_vis("sprite_rows", show_adv && sprite_mode);
+	set_vis("sprite_frames", show_adv && sprite_mode);
+	set_vis("sprite_fps", show_adv && sprite_mode);
+	set_vis("sprite_gif_timing", show_adv && sprite_mode);
+	show_adv_field("text_refresh_ms");
+	show_adv_field("metrics_export");
+	set_vis("metrics_path", show_adv && obs_data_get_int(settings, "metrics_export") != METRICS_EXPORT_OFF);
+	show_adv_field("status_shm");
+	show_adv_field("trace_enabled");
+	set_vis("trace_dump", show_adv && obs_data_get_bool(settings, "trace_enabled"));
+	show_adv_field("record_samples");
 
 	if (obs_property_t *grp = obs_properties_get(props, "dropping_group"))
 		obs_property_set_visible(grp, show_dropping);
 	if (obs_property_t *grp = obs_properties_get(props, "stable_group"))
 		obs_property_set_visible(grp, show_stable);
+	if (obs_property_t *grp = obs_properties_get(props, "cause_group"))
+		obs_property_set_visible(grp, show_causes);
+	if (obs_property_t *grp = obs_properties_get(props, "degrade_group"))
+		obs_property_set_visible(grp, show_warn);
+	if (obs_property_t *grp = obs_properties_get(props, "reconnect_group"))
+		obs_property_set_visible(grp, show_reconnect);
 	return true;
 }
 
-// Advanced testing buttons
+// Animation and easing lists, shared by the dropping and stable groups
+static obs_property_t *add_anim_properties(obs_properties_t *group, const char *kind_key, const char *kind_label,
+					   const char *easing_key, const char *rate_key)
+{
+	obs_property_t *kind =
+		obs_properties_add_list(group, kind_key, kind_label, OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(kind, "None", ANIM_NONE);
+	obs_property_list_add_int(kind, "Blink", ANIM_BLINK);
+	obs_property_list_add_int(kind, "Fade out and in", ANIM_FADE);
+	obs_property_list_add_int(kind, "Pulse", ANIM_PULSE);
+	obs_property_list_add_int(kind, "Slide in", ANIM_SLIDE);
+
+	obs_property_t *easing =
+		obs_properties_add_list(group, easing_key, "Easing", OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(easing, "Linear", EASING_LINEAR);
+	obs_property_list_add_int(easing, "Smooth", EASING_SMOOTH);
+	obs_property_list_add_int(easing, "Ease out", EASING_OUT);
+
+	// Blink rate before animations existed; now the speed of every animation
+	obs_properties_add_float_slider(group, rate_key, "Animation speed (Hz, slide: 1 / seconds)", 0.0, 10.0, 0.1);
+	obs_property_set_modified_callback(kind, online_status_properties_refresh);
+	return kind;
+}
+
+// Advanced testing buttons; the detector belongs to the graphics thread, so they post commands
 static bool online_status_btn_simulate_spike(obs_properties_t * /*props*/, obs_property_t * /*p*/, void *data)
 {
 	auto *s = static_cast<OnlineStatus *>(data);
 	if (!s)
 		return false;
-	s->auto_visible = true;
-	s->since_last_drop = 0.0f;
-	s->stable_visible = false;
-	s->stable_timer = 0.0f;
+	online_status_post_command(s, DROP_COMMAND_TRIGGER);
 	return true; // refresh UI
 }
 
@@ -99,9 +255,25 @@ static bool online_status_btn_show_stable(obs_properties_t * /*props*/, obs_prop
 	auto *s = static_cast<OnlineStatus *>(data);
 	if (!s)
 		return false;
-	s->auto_visible = false;
-	s->stable_visible = true;
-	s->stable_timer = s->stable_duration_sec;
+	online_status_post_command(s, DROP_COMMAND_SHOW_STABLE);
+	return true;
+}
+
+static bool online_status_btn_show_degrading(obs_properties_t * /*props*/, obs_property_t * /*p*/, void *data)
+{
+	auto *s = static_cast<OnlineStatus *>(data);
+	if (!s)
+		return false;
+	online_status_post_command(s, DROP_COMMAND_SHOW_DEGRADING);
+	return true;
+}
+
+static bool online_status_btn_show_reconnecting(obs_properties_t * /*props*/, obs_property_t * /*p*/, void *data)
+{
+	auto *s = static_cast<OnlineStatus *>(data);
+	if (!s)
+		return false;
+	online_status_post_command(s, DROP_COMMAND_SHOW_RECONNECTING);
 	return true;
 }
 
@@ -110,23 +282,37 @@ static bool online_status_btn_hide_all(obs_properties_t * /*props*/, obs_propert
 	auto *s = static_cast<OnlineStatus *>(data);
 	if (!s)
 		return false;
-	s->auto_visible = false;
-	s->stable_visible = false;
-	s->stable_timer = 0.0f;
+	online_status_post_command(s, DROP_COMMAND_HIDE_ALL);
 	return true;
 }
 
+// Tracer output goes next to the incident log; the log says where
+static bool online_status_btn_dump_trace(obs_properties_t * /*props*/, obs_property_t * /*p*/, void * /*data*/)
+{
+	char *path = online_status_trace_dump();
+	if (path)
+		blog(LOG_INFO, "[online-status] Trace saved to %s", path);
+	else
+		blog(LOG_WARNING, "[online-status] No trace saved (turn on recording first)");
+	bfree(path);
+	return false;
+}
+
 obs_properties_t *online_status_properties(void *data)
 {
-	UNUSED_PARAMETER(data);
+	const auto *s = static_cast<const OnlineStatus *>(data);
+	const bool plays_sound = s && s->plays_sound;
 	obs_properties_t *props = obs_properties_create();
 
 	// Section selector to simulate tabs
 	obs_property_t *section =
 		obs_properties_add_list(props, "ui_section", "Section", OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
-	obs_property_list_add_int(section, "Dropping", 0);
-	obs_property_list_add_int(section, "Stable", 1);
-	obs_property_list_add_int(section, "Advanced", 2);
+	obs_property_list_add_int(section, "Dropping", SECTION_DROPPING);
+	obs_property_list_add_int(section, "Causes", SECTION_CAUSES);
+	obs_property_list_add_int(section, "Early warning", SECTION_EARLY_WARNING);
+	obs_property_list_add_int(section, "Reconnecting", SECTION_RECONNECTING);
+	obs_property_list_add_int(section, "Stable", SECTION_STABLE);
+	obs_property_list_add_int(section, "Advanced", SECTION_ADVANCED);
 
 	// Dropping overlay group
 	obs_properties_t *dropping = obs_properties_create();
@@ -134,22 +320,115 @@ obs_properties_t *online_status_properties(void *data)
 						       OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
 	obs_property_list_add_int(mode, "Text", 0);
 	obs_property_list_add_int(mode, "Image", 1);
+	obs_property_list_add_int(mode, "Graph (drop %, lag, bitrate)", CONTENT_GRAPH);
+	obs_property_list_add_int(mode, "Animated image (sprite sheet or GIF)", CONTENT_SPRITE);
 
 	obs_properties_add_text(dropping, "status_text", "Text to show while dropping", OBS_TEXT_DEFAULT);
 	obs_properties_add_path(dropping, "image_path", "Image file (while dropping)", OBS_PATH_FILE,
 				"Image files (*.png *.jpg *.jpeg *.bmp *.gif);;All files (*.*)", nullptr);
 
-	obs_properties_add_float_slider(dropping, "drop_threshold_pct", "Drop % threshold (per-interval)", 0.0, 100.0,
-					0.1);
-	obs_properties_add_float_slider(dropping, "hide_after_sec", "Hide after seconds without drops", 0.0, 30.0, 0.1);
-	// Blink controls (Dropping)
-	obs_properties_add_bool(dropping, "drop_blink_enabled", "Blink (while dropping)");
-	obs_properties_add_float_slider(dropping, "drop_blink_rate_hz", "Blink rate (Hz)", 0.0, 10.0, 0.1);
+	obs_property_t *policy = obs_properties_add_list(dropping, "output_policy", "Watched outputs",
+							 OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(policy, "Streaming output only", OUTPUT_POLICY_STREAMING);
+	obs_property_list_add_int(policy, "All active outputs: worst output", OUTPUT_POLICY_WORST);
+	obs_property_list_add_int(policy, "All active outputs: weighted by frames", OUTPUT_POLICY_WEIGHTED);
+	obs_property_list_add_int(policy, "All active outputs: any drop", OUTPUT_POLICY_ANY);
+
+	obs_properties_add_float_slider(dropping, "drop_threshold_pct", "Drop % threshold to show (over window)", 0.0,
+					100.0, 0.1);
+	obs_properties_add_float_slider(dropping, "drop_exit_threshold_pct", "Drop % threshold to keep showing", 0.0,
+					100.0, 0.1);
+	obs_property_t *window = obs_properties_add_int_slider(dropping, "drop_window_ms", "Drop % window", 250,
+							       10000, 50);
+	obs_property_int_set_suffix(window, " ms");
+	// Adaptive: alert when drops are unusual for this stream; the fixed thresholds apply
+	// while it learns and set the keep-showing ratio
+	obs_property_t *threshold_mode = obs_properties_add_list(dropping, "drop_threshold_mode", "Threshold",
+								 OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(threshold_mode, "Fixed", THRESHOLD_FIXED);
+	obs_property_list_add_int(threshold_mode, "Adaptive (learned from this stream)", THRESHOLD_ADAPTIVE);
+	obs_property_set_modified_callback(threshold_mode, online_status_properties_refresh);
+	obs_properties_add_float_slider(dropping, "adaptive_quantile", "Alert above this percentile of usual drops",
+					50.0, 99.9, 0.1);
+	obs_property_t *learn = obs_properties_add_int_slider(dropping, "adaptive_learn_sec",
+							      "Learn for (fixed threshold until then)", 30, 1800, 10);
+	obs_property_int_set_suffix(learn, " s");
+	obs_properties_add_float_slider(dropping, "adaptive_min_pct", "Never alert below drop %", 0.0, 10.0, 0.01);
+	obs_properties_add_float_slider(dropping, "hide_after_sec", "Hide after seconds below keep-showing threshold",
+					0.0, 30.0, 0.1);
+	// Animation (Dropping)
+	add_anim_properties(dropping, "drop_anim", "Animation (while dropping)", "drop_anim_easing",
+			    "drop_blink_rate_hz");
+	// Audio cue (volume and monitoring: the source's entry in the audio mixer)
+	if (plays_sound)
+		obs_properties_add_bool(dropping, "drop_sound", "Play a sound when the overlay appears");
 
 	obs_property_t *dropping_group =
 		obs_properties_add_group(props, "dropping_group", "When dropping frames", OBS_GROUP_NORMAL, dropping);
 	obs_properties_add_bool(props, "visible", "Test text that auto-shows when dropping frames(for debugging)");
 
+	// Causes group: which signals trigger the overlay and what each one shows
+	obs_properties_t *causes = obs_properties_create();
+	obs_properties_add_bool(causes, "watch_network", "Network: dropped frames");
+	obs_properties_add_bool(causes, "watch_encoder", "Encoder overload: skipped frames");
+	obs_property_t *enc_mode = obs_properties_add_list(causes, "encoder_mode", "Content Type (encoder overload)",
+							   OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(enc_mode, "Same as dropping", CONTENT_SAME_AS_DROPPING);
+	obs_property_list_add_int(enc_mode, "Text", CONTENT_TEXT);
+	obs_property_list_add_int(enc_mode, "Image", CONTENT_IMAGE);
+	obs_properties_add_text(causes, "encoder_text", "Text to show on encoder overload", OBS_TEXT_DEFAULT);
+	obs_properties_add_path(causes, "encoder_image_path", "Image file (encoder overload)", OBS_PATH_FILE,
+				"Image files (*.png *.jpg *.jpeg *.bmp *.gif);;All files (*.*)", nullptr);
+	obs_properties_add_bool(causes, "watch_render", "Rendering lag: lagged frames");
+	obs_property_t *ren_mode = obs_properties_add_list(causes, "render_mode", "Content Type (rendering lag)",
+							   OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(ren_mode, "Same as dropping", CONTENT_SAME_AS_DROPPING);
+	obs_property_list_add_int(ren_mode, "Text", CONTENT_TEXT);
+	obs_property_list_add_int(ren_mode, "Image", CONTENT_IMAGE);
+	obs_properties_add_text(causes, "render_text", "Text to show on rendering lag", OBS_TEXT_DEFAULT);
+	obs_properties_add_path(causes, "render_image_path", "Image file (rendering lag)", OBS_PATH_FILE,
+				"Image files (*.png *.jpg *.jpeg *.bmp *.gif);;All files (*.*)", nullptr);
+
+	obs_properties_add_group(props, "cause_group", "What counts as dropping", OBS_GROUP_NORMAL, causes);
+
+	// Early warning group: congestion/bitrate trend before frames drop
+	obs_properties_t *warn = obs_properties_create();
+	obs_properties_add_bool(warn, "degrade_enabled", "Warn before frames drop (congestion / bitrate trend)");
+	obs_property_t *cong = obs_properties_add_float_slider(warn, "degrade_congestion_pct",
+							       "Warn at congestion", 0.0, 100.0, 1.0);
+	obs_property_float_set_suffix(cong, " %");
+	obs_property_t *slope = obs_properties_add_float_slider(warn, "degrade_slope_pct",
+								"Warn when congestion rises faster than (0 = off)", 0.0,
+								100.0, 1.0);
+	obs_property_float_set_suffix(slope, " %/s");
+	obs_property_t *sag = obs_properties_add_float_slider(warn, "degrade_bitrate_drop_pct",
+							      "Warn when bitrate falls below its average by (0 = off)",
+							      0.0, 100.0, 1.0);
+	obs_property_float_set_suffix(sag, " %");
+	obs_property_t *warn_mode = obs_properties_add_list(warn, "degrade_mode", "Content Type (early warning)",
+							    OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(warn_mode, "Text", CONTENT_TEXT);
+	obs_property_list_add_int(warn_mode, "Image", CONTENT_IMAGE);
+	obs_properties_add_text(warn, "degrade_text", "Text to show as early warning", OBS_TEXT_DEFAULT);
+	obs_properties_add_path(warn, "degrade_image_path", "Image file (early warning)", OBS_PATH_FILE,
+				"Image files (*.png *.jpg *.jpeg *.bmp *.gif);;All files (*.*)", nullptr);
+
+	obs_properties_add_group(props, "degrade_group", "Early warning", OBS_GROUP_NORMAL, warn);
+
+	// Reconnecting group: shown while the streaming output retries its connection
+	obs_properties_t *rec = obs_properties_create();
+	obs_properties_add_bool(rec, "reconnect_enabled", "Show while the stream is reconnecting");
+	obs_property_t *rec_mode = obs_properties_add_list(rec, "reconnect_mode", "Content Type (reconnecting)",
+							   OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(rec_mode, "Text", CONTENT_TEXT);
+	obs_property_list_add_int(rec_mode, "Image", CONTENT_IMAGE);
+	obs_properties_add_text(rec, "reconnect_text", "Text to show while reconnecting", OBS_TEXT_DEFAULT);
+	obs_properties_add_bool(rec, "reconnect_show_elapsed", "Append time spent reconnecting (m:ss)");
+	obs_properties_add_path(rec, "reconnect_image_path", "Image file (reconnecting)", OBS_PATH_FILE,
+				"Image files (*.png *.jpg *.jpeg *.bmp *.gif);;All files (*.*)", nullptr);
+
+	obs_properties_add_group(props, "reconnect_group", "Reconnecting", OBS_GROUP_NORMAL, rec);
+
 	// Stable overlay group
 	obs_properties_t *stable = obs_properties_create();
 	obs_properties_add_bool(stable, "stable_enabled", "Show message when connection is stable");
@@ -157,26 +436,92 @@ obs_properties_t *online_status_properties(void *data)
 							OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
 	obs_property_list_add_int(smode, "Text", 0);
 	obs_property_list_add_int(smode, "Image", 1);
+	obs_property_list_add_int(smode, "Graph (drop %, lag, bitrate)", CONTENT_GRAPH);
+	obs_property_list_add_int(smode, "Animated image (sprite sheet or GIF)", CONTENT_SPRITE);
 	obs_properties_add_text(stable, "stable_text", "Stable text", OBS_TEXT_DEFAULT);
 	obs_properties_add_path(stable, "stable_image_path", "Stable image file", OBS_PATH_FILE,
 				"Image files (*.png *.jpg *.jpeg *.bmp *.gif);;All files (*.*)", nullptr);
 	obs_properties_add_float_slider(stable, "stable_duration_sec", "Stable message duration (seconds)", 0.0, 60.0,
 					0.1);
-	// Blink controls (Stable)
-	obs_properties_add_bool(stable, "stable_blink_enabled", "Blink (stable message)");
-	obs_properties_add_float_slider(stable, "stable_blink_rate_hz", "Blink rate (Hz)", 0.0, 10.0, 0.1);
+	// Animation (Stable)
+	add_anim_properties(stable, "stable_anim", "Animation (stable message)", "stable_anim_easing",
+			    "stable_blink_rate_hz");
+	if (plays_sound)
+		obs_properties_add_bool(stable, "stable_sound", "Play a sound when the stable message appears");
 
 	obs_property_t *stable_group =
 		obs_properties_add_group(props, "stable_group", "When connection stabilizes", OBS_GROUP_NORMAL, stable);
 
+	// Advanced: copies with the same group share one overlay
+	obs_properties_add_text(props, "link_group", "Linked group (copies with the same name show one shared overlay)",
+				OBS_TEXT_DEFAULT);
+
 	// Advanced: testing controls
 	obs_properties_add_bool(props, "test_force_drop", "Test: Force dropping overlay");
 	obs_properties_add_button(props, "test_simulate_spike", "Test: Simulate drop spike",
 				  online_status_btn_simulate_spike);
 	obs_properties_add_button(props, "test_show_stable", "Test: Show stable message now",
 				  online_status_btn_show_stable);
+	obs_properties_add_button(props, "test_show_degrading", "Test: Show early warning now",
+				  online_status_btn_show_degrading);
+	obs_properties_add_button(props, "test_show_reconnecting", "Test: Show reconnecting now",
+				  online_status_btn_show_reconnecting);
 	obs_properties_add_button(props, "test_hide_all", "Test: Hide overlays", online_status_btn_hide_all);
 
+	// Advanced: shared stats sampler
+	obs_property_t *interval = obs_properties_add_int_slider(
+		props, "stats_interval_ms", "Stats sample interval (ms, shared by all Online Status sources)", 10,
+		1000, 10);
+	obs_property_int_set_suffix(interval, " ms");
+
+	// Advanced: draw the shown overlay from a cached texture
+	obs_properties_add_bool(props, "render_cache", "Cache overlay as a texture (redraw only when it changes)");
+
+	// Advanced: time span of the graph content mode
+	obs_property_t *graph = obs_properties_add_int_slider(props, "graph_seconds", "Graph span", 5, 300, 5);
+	obs_property_int_set_suffix(graph, " s");
+
+	// Advanced: sprite sheet layout and playback (GIFs bring their own frames)
+	obs_properties_add_int(props, "sprite_columns", "Sprite sheet columns", 1, 64, 1);
+	obs_properties_add_int(props, "sprite_rows", "Sprite sheet rows", 1, 64, 1);
+	obs_properties_add_int(props, "sprite_frames", "Sprite sheet frames (0 = every cell)", 0, 4096, 1);
+	obs_property_t *fps = obs_properties_add_float_slider(props, "sprite_fps", "Sprite frame rate", 0.0, 60.0, 0.5);
+	obs_property_float_set_suffix(fps, " fps");
+	obs_properties_add_bool(props, "sprite_gif_timing", "GIFs: keep the file's own frame timing");
+
+	// Advanced: how often texts with {variables} may change
+	obs_property_t *refresh = obs_properties_add_int_slider(props, "text_refresh_ms",
+								"Live text refresh (texts with {variables})", 100, 5000,
+								100);
+	obs_property_int_set_suffix(refresh, " ms");
+
+	// Advanced: Prometheus metrics for dashboards (module-wide)
+	obs_property_t *metrics = obs_properties_add_list(props, "metrics_export",
+							  "Export metrics (shared by all Online Status sources)",
+							  OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(metrics, "Off", METRICS_EXPORT_OFF);
+	obs_property_list_add_int(metrics, "File (rewritten every 5 s)", METRICS_EXPORT_FILE);
+#ifndef _WIN32
+	obs_property_list_add_int(metrics, "Unix socket (HTTP)", METRICS_EXPORT_SOCKET);
+#endif
+	obs_properties_add_path(props, "metrics_path", "Metrics file or socket", OBS_PATH_FILE_SAVE,
+				"Prometheus text (*.prom);;All files (*.*)", nullptr);
+	obs_property_set_modified_callback(metrics, online_status_properties_refresh);
+
+	// Advanced: live status for stream decks and tally tools (module-wide)
+	obs_properties_add_bool(props, "status_shm",
+				"Publish live status in shared memory (shared by all Online Status sources)");
+
+	// Advanced: per-call timings for chrome://tracing (module-wide)
+	obs_property_t *trace = obs_properties_add_bool(
+		props, "trace_enabled", "Record a timing trace (shared by all Online Status sources)");
+	obs_property_set_modified_callback(trace, online_status_properties_refresh);
+	obs_properties_add_button(props, "trace_dump", "Save trace (Chrome trace JSON)", online_status_btn_dump_trace);
+
+	// Advanced: detector input for online-status-replay (module-wide)
+	obs_properties_add_bool(props, "record_samples",
+				"Record stats samples for offline replay (shared by all Online Status sources)");
+
 	// Dynamic visibility handled by C-callback online_status_properties_refresh()
 
 	// Hook callbacks
@@ -190,6 +535,19 @@ obs_properties_t *online_status_properties(void *data)
 				obs_property_set_modified_callback(pp, online_status_properties_refresh);
 		}
 	}
+	// Cause toggles and modes change which fields are shown
+	obs_property_set_modified_callback(enc_mode, online_status_properties_refresh);
+	obs_property_set_modified_callback(ren_mode, online_status_properties_refresh);
+	if (obs_property_t *pp = obs_properties_get(causes, "watch_encoder"))
+		obs_property_set_modified_callback(pp, online_status_properties_refresh);
+	if (obs_property_t *pp = obs_properties_get(causes, "watch_render"))
+		obs_property_set_modified_callback(pp, online_status_properties_refresh);
+	obs_property_set_modified_callback(warn_mode, online_status_properties_refresh);
+	if (obs_property_t *pp = obs_properties_get(warn, "degrade_enabled"))
+		obs_property_set_modified_callback(pp, online_status_properties_refresh);
+	obs_property_set_modified_callback(rec_mode, online_status_properties_refresh);
+	if (obs_property_t *pp = obs_properties_get(rec, "reconnect_enabled"))
+		obs_property_set_modified_callback(pp, online_status_properties_refresh);
 	// Also attach to stable group inner toggles
 	if (obs_property_t *grp = stable_group) {
 		obs_properties_t *inner = obs_property_group_content(grp);
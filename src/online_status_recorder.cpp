@@ -0,0 +1,357 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_recorder.hpp"
+#include "core/sample_trace.hpp"
+#include <obs-module.h>
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+    Ticks encode into a small per-recorder buffer reserved up front and copy the record into
+    the recorder's ring, which the writer thread drains every second, so the graphics thread
+    neither locks nor allocates and never waits on files. Every time recording is turned on
+    a new session starts: each source then starts a new file, and its encoder a new delta
+    base, with the first tick it records.
+*/
+
+static constexpr uint32_t kFlushIntervalMs = 1000;
+static constexpr size_t kRingSize = 64 * 1024; // about 40 s of a streaming source
+static constexpr size_t kMaxRecord = 256;      // largest encoded tick, with a config block
+static constexpr size_t kBufferReserve = 16 * 1024;
+
+// Ring framing of one encoded tick
+struct RingFrame {
+	uint32_t session; // recording the tick belongs to
+	uint32_t size;    // bytes of the record that follows
+};
+
+struct SampleRecorder {
+	uint32_t id = 0;
+	std::string name; // g_mutex
+
+	// Graphics thread only
+	uint32_t session = 0;    // recording the encoder state belongs to
+	uint64_t config_gen = 0; // snapshot of the last written settings
+	float idle_sec = 0.0f;   // skipped since the last recorded tick
+	SampleTraceWriter writer;
+	std::vector<uint8_t> record; // one encoded tick; reserved at registration, never grows
+
+	// Single producer (graphics thread), single consumer (writer, g_mutex)
+	std::atomic<uint8_t *> ring{nullptr}; // kRingSize bytes, allocated when recording starts
+	std::atomic<uint64_t> head{0};
+	std::atomic<uint64_t> tail{0};
+	std::atomic<uint32_t> lost{0}; // ticks left out because the ring was full
+
+	// Writer (g_mutex)
+	std::vector<uint8_t> spare;
+	FILE *file = nullptr;
+	uint32_t file_session = 0;
+};
+
+static std::mutex g_mutex; // registry, names, rings and files
+static std::vector<SampleRecorder *> g_recorders;
+static uint32_t g_next_id = 1;
+static std::atomic<uint32_t> g_session{0}; // current recording, 0 while off
+
+static std::mutex g_config_mutex; // g_last_session and writer thread lifetime
+static uint32_t g_last_session = 0;
+static std::thread g_thread;
+static std::mutex g_wake_mutex;
+static std::condition_variable g_wake;
+static std::atomic<bool> g_stop{false};
+
+// ------------------------ Ring ------------------------
+static void ring_copy_in(uint8_t *ring, uint64_t pos, const void *src, size_t size)
+{
+	const size_t at = (size_t)(pos % kRingSize);
+	const size_t first = std::min(size, kRingSize - at);
+	memcpy(ring + at, src, first);
+	memcpy(ring, static_cast<const uint8_t *>(src) + first, size - first);
+}
+
+static void ring_copy_out(const uint8_t *ring, uint64_t pos, void *dst, size_t size)
+{
+	const size_t at = (size_t)(pos % kRingSize);
+	const size_t first = std::min(size, kRingSize - at);
+	memcpy(dst, ring + at, first);
+	memcpy(static_cast<uint8_t *>(dst) + first, ring, size - first);
+}
+
+// Graphics thread: false when the writer fell behind and the ring is full
+static bool ring_push(SampleRecorder *r, uint8_t *ring, uint32_t session)
+{
+	const RingFrame frame = {session, (uint32_t)r->record.size()};
+	const uint64_t head = r->head.load(std::memory_order_relaxed);
+	const uint64_t tail = r->tail.load(std::memory_order_acquire);
+	if (kRingSize - (size_t)(head - tail) < sizeof(frame) + frame.size)
+		return false;
+	ring_copy_in(ring, head, &frame, sizeof(frame));
+	ring_copy_in(ring, head + sizeof(frame), r->record.data(), frame.size);
+	r->head.store(head + sizeof(frame) + frame.size, std::memory_order_release);
+	return true;
+}
+
+// UI thread, g_mutex held: rings are only needed once something records
+static void ring_alloc(SampleRecorder *r)
+{
+	if (!r->ring.load(std::memory_order_relaxed))
+		r->ring.store(new uint8_t[kRingSize], std::memory_order_release);
+}
+
+// ------------------------ Graphics thread ------------------------
+void online_status_recorder_tick(SampleRecorder *r, uint64_t config_gen, const DropDetectorConfig *cfg,
+				 uint32_t commands, bool rebased, const DropSample *sample, float seconds)
+{
+	const uint32_t session = g_session.load(std::memory_order_relaxed);
+	if (!r || !session)
+		return;
+	uint8_t *ring = r->ring.load(std::memory_order_acquire);
+	if (!ring)
+		return;
+	if (r->session != session) {
+		r->session = session;
+		r->writer = SampleTraceWriter{};
+		r->config_gen = 0;
+		r->idle_sec = 0.0f;
+	}
+	const bool config_changed = config_gen != r->config_gen;
+
+	// The encoder state only advances with a record that made it into the ring
+	SampleTraceWriter writer = r->writer;
+	r->record.clear();
+	sample_trace_write_tick(&writer, &r->record, seconds, r->idle_sec, commands, rebased,
+				config_changed ? cfg : nullptr, sample);
+	if (!ring_push(r, ring, session)) {
+		// Replays keep the time; the settings follow with the next record
+		r->lost.fetch_add(1, std::memory_order_relaxed);
+		r->idle_sec += seconds;
+		return;
+	}
+	r->writer = writer;
+	r->config_gen = config_gen;
+	r->idle_sec = 0.0f;
+}
+
+void online_status_recorder_idle(SampleRecorder *r, float seconds)
+{
+	const uint32_t session = g_session.load(std::memory_order_relaxed);
+	if (r && session && r->session == session)
+		r->idle_sec += seconds;
+}
+
+// ------------------------ Files (g_mutex held) ------------------------
+// Source names can hold anything; keep file names portable
+static std::string file_label(const std::string &name)
+{
+	std::string label;
+	for (char ch : name.substr(0, 40)) {
+		const bool plain = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') ||
+				   ch == '-' || ch == '_';
+		label += plain ? ch : '_';
+	}
+	return label.empty() ? "source" : label;
+}
+
+static void close_file(SampleRecorder *r)
+{
+	if (r->file)
+		fclose(r->file);
+	r->file = nullptr;
+}
+
+static FILE *open_file(SampleRecorder *r)
+{
+	using namespace std::chrono;
+	const uint64_t now_ms = (uint64_t)duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+	const time_t now = (time_t)(now_ms / 1000);
+	struct tm local;
+#ifdef _WIN32
+	localtime_s(&local, &now);
+#else
+	localtime_r(&now, &local);
+#endif
+	char stamp[32];
+	strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+	// The id keeps sources with the same name apart
+	const std::string file = std::string("samples-") + stamp + "-" + file_label(r->name) + "-" +
+				 std::to_string(r->id) + ".bin";
+
+	char *dir = obs_module_config_path("");
+	char *path = obs_module_config_path(file.c_str());
+	if (dir)
+		os_mkdirs(dir);
+	bfree(dir);
+	FILE *f = path ? os_fopen(path, "wb") : nullptr;
+	if (f) {
+		std::vector<uint8_t> header;
+		sample_trace_write_header(&header, now_ms);
+		fwrite(header.data(), 1, header.size(), f);
+		blog(LOG_INFO, "[online-status] Recording samples of '%s' to %s", r->name.c_str(), path);
+	} else {
+		blog(LOG_WARNING, "[online-status] Could not create the sample trace %s", path ? path : file.c_str());
+	}
+	bfree(path);
+	return f;
+}
+
+static void write_spare(SampleRecorder *r)
+{
+	if (r->file && !r->spare.empty()) {
+		fwrite(r->spare.data(), 1, r->spare.size(), r->file);
+		fflush(r->file);
+	}
+	r->spare.clear();
+}
+
+// Append what the source recorded since the last flush
+static void flush(SampleRecorder *r)
+{
+	const uint8_t *ring = r->ring.load(std::memory_order_acquire);
+	if (!ring)
+		return;
+	const uint64_t head = r->head.load(std::memory_order_acquire);
+	uint64_t tail = r->tail.load(std::memory_order_relaxed);
+	while (tail != head) {
+		RingFrame frame;
+		ring_copy_out(ring, tail, &frame, sizeof(frame));
+		tail += sizeof(frame);
+		// Ticks of an earlier session are from a file already closed
+		if (frame.session > r->file_session) {
+			write_spare(r);
+			close_file(r);
+			r->file = open_file(r);
+			r->file_session = frame.session;
+		}
+		if (frame.session == r->file_session && r->file) {
+			const size_t at = r->spare.size();
+			r->spare.resize(at + frame.size);
+			ring_copy_out(ring, tail, r->spare.data() + at, frame.size);
+		}
+		tail += frame.size;
+	}
+	r->tail.store(tail, std::memory_order_release);
+	write_spare(r);
+	// Kept for the next flush
+	r->spare.reserve(kBufferReserve);
+
+	if (const uint32_t lost = r->lost.exchange(0, std::memory_order_relaxed))
+		blog(LOG_WARNING, "[online-status] Sample trace of '%s' is missing %u ticks (writer fell behind)",
+		     r->name.c_str(), lost);
+}
+
+// ------------------------ Writer thread ------------------------
+static void flush_all(bool close)
+{
+	std::lock_guard<std::mutex> lock(g_mutex);
+	for (SampleRecorder *r : g_recorders) {
+		flush(r);
+		if (close)
+			close_file(r);
+	}
+}
+
+static void writer_thread(void)
+{
+	os_set_thread_name("online-status: samples");
+	std::unique_lock<std::mutex> lock(g_wake_mutex);
+	while (!g_stop.load(std::memory_order_relaxed)) {
+		lock.unlock();
+		flush_all(false);
+		lock.lock();
+		g_wake.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs),
+				[] { return g_stop.load(std::memory_order_relaxed); });
+	}
+	lock.unlock();
+	flush_all(true);
+}
+
+// g_config_mutex held
+static void stop_thread_locked(void)
+{
+	g_session.store(0, std::memory_order_relaxed);
+	{
+		std::lock_guard<std::mutex> lock(g_wake_mutex);
+		g_stop.store(true, std::memory_order_relaxed);
+	}
+	g_wake.notify_all();
+	if (g_thread.joinable())
+		g_thread.join();
+}
+
+// ------------------------ Registry ------------------------
+SampleRecorder *online_status_recorder_register(const char *name)
+{
+	auto *r = new SampleRecorder();
+	r->name = name ? name : "";
+	r->record.reserve(kMaxRecord);
+	std::lock_guard<std::mutex> lock(g_mutex);
+	r->id = g_next_id++;
+	if (g_session.load(std::memory_order_relaxed))
+		ring_alloc(r);
+	g_recorders.push_back(r);
+	return r;
+}
+
+// The source no longer ticks; keep what it recorded
+void online_status_recorder_unregister(SampleRecorder *r)
+{
+	if (!r)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		g_recorders.erase(std::remove(g_recorders.begin(), g_recorders.end(), r), g_recorders.end());
+		flush(r);
+		close_file(r);
+	}
+	delete[] r->ring.load(std::memory_order_relaxed);
+	delete r;
+}
+
+void online_status_recorder_rename(SampleRecorder *r, const char *name)
+{
+	if (!r)
+		return;
+	std::lock_guard<std::mutex> lock(g_mutex);
+	r->name = name ? name : "";
+}
+
+// ------------------------ Lifetime ------------------------
+void online_status_recorder_configure(bool enabled)
+{
+	std::lock_guard<std::mutex> lock(g_config_mutex);
+	if (enabled == (g_session.load(std::memory_order_relaxed) != 0))
+		return;
+	if (!enabled) {
+		stop_thread_locked();
+		blog(LOG_INFO, "[online-status] Sample recording stopped");
+		return;
+	}
+
+	if (++g_last_session == 0)
+		g_last_session = 1;
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		for (SampleRecorder *r : g_recorders)
+			ring_alloc(r);
+	}
+	g_stop.store(false, std::memory_order_relaxed);
+	g_thread = std::thread(writer_thread);
+	g_session.store(g_last_session, std::memory_order_relaxed);
+	blog(LOG_INFO, "[online-status] Sample recording started");
+}
+
+void online_status_recorder_stop(void)
+{
+	std::lock_guard<std::mutex> lock(g_config_mutex);
+	stop_thread_locked();
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include "core/drop_detector.hpp"
+
+// Optional recorder of the detector's input, for replaying a stream offline with
+// online-status-replay (see core/sample_trace.hpp). While recording, each tick encodes its
+// sample into the source's preallocated ring without locking; a module-level thread drains
+// the rings into one file per source in the plugin config directory every second.
+struct SampleRecorder;
+
+// UI thread: per-source recorder, named after the source (the name goes into the file name)
+SampleRecorder *online_status_recorder_register(const char *name);
+void online_status_recorder_unregister(SampleRecorder *recorder);
+void online_status_recorder_rename(SampleRecorder *recorder, const char *name);
+
+// Recording is shared by every Online Status source; the last edited source wins.
+// Turning it on starts new files.
+void online_status_recorder_configure(bool enabled);
+
+// Graphics thread, after the detector ticked with this sample. config_gen identifies the
+// snapshot cfg belongs to, so settings are only written when they changed; rebased is set
+// when the detector was rebased before this tick.
+void online_status_recorder_tick(SampleRecorder *recorder, uint64_t config_gen, const DropDetectorConfig *cfg,
+				 uint32_t commands, bool rebased, const DropSample *sample, float seconds);
+
+// Graphics thread: a tick skipped as idle, without ticking the detector
+void online_status_recorder_idle(SampleRecorder *recorder, float seconds);
+
+// obs_module_unload: write out what is left and close the files
+void online_status_recorder_stop(void);
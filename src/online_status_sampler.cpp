@@ -0,0 +1,418 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_sampler.hpp"
+#include <obs-frontend-api.h>
+#include <util/platform.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    One background thread samples the outputs for every Online Status source.
+    Snapshots go into a small ring of slots and are published by bumping a counter, so the
+    graphics thread only copies a slot and never takes a lock (seqlock-style validation).
+
+    For the all-output policies the sampler keeps weak references to the active outputs and
+    only re-enumerates them every few seconds, so a sample is one ref/unref per output.
+
+    The streaming output is not looked up per sample. Frontend streaming events attach to it
+    once, its start/stop/reconnect signals drive the stream state and wake the thread right
+    away, and while nothing is streaming (and no source watches all outputs) the thread
+    publishes one idle snapshot and sleeps until the next event.
+*/
+
+static constexpr uint32_t kMinIntervalMs = 10;
+static constexpr uint32_t kMaxIntervalMs = 1000;
+static constexpr uint64_t kSlotCount = 4; // power of two
+static constexpr size_t kMaxTrackedOutputs = 16;
+static constexpr uint64_t kEnumIntervalNs = 2000000000ULL; // output cache refresh
+
+static OutputStatsSnapshot g_slots[kSlotCount];
+static std::atomic<uint64_t> g_writing{0};   // seq of the slot currently being written
+static std::atomic<uint64_t> g_published{0}; // seq of the newest complete slot
+static std::atomic<uint32_t> g_interval_ms{100};
+static std::atomic<int> g_enum_users{0};
+
+static std::thread g_thread;
+static std::mutex g_wake_mutex;
+static std::condition_variable g_wake;
+static bool g_stop = true;
+static bool g_kick = false; // sample now instead of waiting out the interval
+
+// Streaming output, cached between the streaming start and stop events
+static std::mutex g_stream_mutex;               // guards g_stream_output
+static obs_output_t *g_stream_output = nullptr; // strong reference
+static std::atomic<int> g_stream_state{STREAM_STATE_IDLE};
+
+static void kick(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(g_wake_mutex);
+		g_kick = true;
+	}
+	g_wake.notify_all();
+}
+
+// ------------------------ Publishing ------------------------
+static void publish(const OutputStatsSnapshot &snap)
+{
+	const uint64_t seq = g_published.load(std::memory_order_relaxed) + 1;
+	g_writing.store(seq, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	OutputStatsSnapshot &slot = g_slots[seq & (kSlotCount - 1)];
+	slot = snap;
+	slot.seq = seq;
+	g_published.store(seq, std::memory_order_release);
+}
+
+bool online_status_sampler_read(OutputStatsSnapshot *out)
+{
+	for (;;) {
+		const uint64_t seq = g_published.load(std::memory_order_acquire);
+		if (seq == 0)
+			return false;
+		*out = g_slots[seq & (kSlotCount - 1)];
+		std::atomic_thread_fence(std::memory_order_acquire);
+		// Valid unless the writer lapped the ring and started reusing our slot
+		if (g_writing.load(std::memory_order_relaxed) - seq < kSlotCount)
+			return true;
+	}
+}
+
+uint64_t online_status_sampler_seq(void)
+{
+	return g_published.load(std::memory_order_acquire);
+}
+
+// ------------------------ Streaming output lifecycle ------------------------
+// Signal handlers run on output threads; they only flip the state and wake the sampler
+static void set_stream_state(int state)
+{
+	g_stream_state.store(state, std::memory_order_release);
+	kick();
+}
+
+static void on_output_start(void *, calldata_t *)
+{
+	set_stream_state(STREAM_STATE_ACTIVE);
+}
+
+static void on_output_stop(void *, calldata_t *)
+{
+	set_stream_state(STREAM_STATE_IDLE);
+}
+
+static void on_output_reconnect(void *, calldata_t *)
+{
+	set_stream_state(STREAM_STATE_RECONNECTING);
+}
+
+static void on_output_reconnect_success(void *, calldata_t *)
+{
+	set_stream_state(STREAM_STATE_ACTIVE);
+}
+
+struct OutputSignal {
+	const char *name;
+	signal_callback_t callback;
+};
+
+static const OutputSignal kOutputSignals[] = {
+	{"start", on_output_start},
+	{"stop", on_output_stop},
+	{"reconnect", on_output_reconnect},
+	{"reconnect_success", on_output_reconnect_success},
+};
+
+static void detach_streaming_output_locked(void)
+{
+	if (!g_stream_output)
+		return;
+	signal_handler_t *sh = obs_output_get_signal_handler(g_stream_output);
+	for (const OutputSignal &sig : kOutputSignals)
+		signal_handler_disconnect(sh, sig.name, sig.callback, nullptr);
+	obs_output_release(g_stream_output);
+	g_stream_output = nullptr;
+}
+
+static void attach_streaming_output(void)
+{
+	obs_output_t *out = obs_frontend_get_streaming_output();
+	if (!out)
+		return;
+
+	std::lock_guard<std::mutex> lock(g_stream_mutex);
+	if (out == g_stream_output) {
+		obs_output_release(out);
+		return;
+	}
+	detach_streaming_output_locked();
+	signal_handler_t *sh = obs_output_get_signal_handler(out);
+	for (const OutputSignal &sig : kOutputSignals)
+		signal_handler_connect(sh, sig.name, sig.callback, nullptr);
+	g_stream_output = out; // keeps the reference from obs_frontend_get_streaming_output
+}
+
+static void detach_streaming_output(void)
+{
+	std::lock_guard<std::mutex> lock(g_stream_mutex);
+	detach_streaming_output_locked();
+}
+
+// ------------------------ Output cache (sampler thread only) ------------------------
+struct TrackedOutput {
+	obs_weak_output_t *weak = nullptr;
+	uint64_t prev_total = 0;
+	uint64_t prev_dropped = 0;
+	uint64_t prev_bytes = 0;
+};
+
+static std::vector<TrackedOutput> g_tracked;
+static uint64_t g_last_enum_ns = 0;
+static PolicyStats g_acc[OUTPUT_POLICY_COUNT]; // monotonic all-output accumulators
+
+// Enumeration stopped; the next start tracks and accumulates from scratch
+static void clear_tracked(void)
+{
+	for (TrackedOutput &t : g_tracked)
+		obs_weak_output_release(t.weak);
+	g_tracked.clear();
+	g_last_enum_ns = 0;
+	for (PolicyStats &acc : g_acc)
+		acc = PolicyStats{};
+}
+
+static bool is_tracked(obs_output_t *output)
+{
+	for (const TrackedOutput &t : g_tracked) {
+		if (obs_weak_output_references_output(t.weak, output))
+			return true;
+	}
+	return false;
+}
+
+static bool enum_active_output(void *, obs_output_t *output)
+{
+	if (g_tracked.size() >= kMaxTrackedOutputs)
+		return false;
+	if (!obs_output_active(output) || is_tracked(output))
+		return true;
+
+	TrackedOutput t;
+	t.weak = obs_output_get_weak_output(output);
+	// Start from the current counters so a late join does not look like a burst
+	t.prev_total = (uint64_t)obs_output_get_total_frames(output);
+	t.prev_dropped = (uint64_t)obs_output_get_frames_dropped(output);
+	t.prev_bytes = obs_output_get_total_bytes(output);
+	g_tracked.push_back(t);
+	return true;
+}
+
+// Deltas of every tracked output folded into the all-output accumulators
+static void sample_tracked(OutputStatsSnapshot &snap)
+{
+	uint64_t sum_total = 0, sum_drop = 0;
+	uint64_t worst_total = 0, worst_drop = 0;
+	uint64_t sum_bytes = 0;
+	float worst_congestion = 0.0f;
+	bool any_active = false;
+
+	for (size_t i = 0; i < g_tracked.size();) {
+		TrackedOutput &t = g_tracked[i];
+		obs_output_t *out = obs_weak_output_get_output(t.weak);
+		if (!out) {
+			// Output was destroyed; forget it
+			obs_weak_output_release(t.weak);
+			g_tracked.erase(g_tracked.begin() + (ptrdiff_t)i);
+			continue;
+		}
+		if (obs_output_active(out)) {
+			any_active = true;
+			const uint64_t total = (uint64_t)obs_output_get_total_frames(out);
+			const uint64_t dropped = (uint64_t)obs_output_get_frames_dropped(out);
+			// Reset counters if the output restarted
+			if (total < t.prev_total || dropped < t.prev_dropped) {
+				t.prev_total = total;
+				t.prev_dropped = dropped;
+			}
+			const uint64_t d_total = total - t.prev_total;
+			const uint64_t d_drop = dropped - t.prev_dropped;
+			t.prev_total = total;
+			t.prev_dropped = dropped;
+
+			const uint64_t bytes = obs_output_get_total_bytes(out);
+			if (bytes >= t.prev_bytes)
+				sum_bytes += bytes - t.prev_bytes;
+			t.prev_bytes = bytes;
+			const float congestion = obs_output_get_congestion(out);
+			if (congestion > worst_congestion)
+				worst_congestion = congestion;
+
+			sum_total += d_total;
+			sum_drop += d_drop;
+			// Worst: highest drop ratio, compared without division
+			if (d_total > 0 && (worst_total == 0 || d_drop * worst_total > worst_drop * d_total)) {
+				worst_total = d_total;
+				worst_drop = d_drop;
+			}
+		}
+		obs_output_release(out);
+		i++;
+	}
+
+	g_acc[OUTPUT_POLICY_WORST].total += worst_total;
+	g_acc[OUTPUT_POLICY_WORST].dropped += worst_drop;
+	g_acc[OUTPUT_POLICY_WEIGHTED].total += sum_total;
+	g_acc[OUTPUT_POLICY_WEIGHTED].dropped += sum_drop;
+	g_acc[OUTPUT_POLICY_ANY].total += sum_total;
+	g_acc[OUTPUT_POLICY_ANY].dropped += sum_drop > 0 ? sum_total : 0;
+	for (int p = OUTPUT_POLICY_WORST; p < OUTPUT_POLICY_COUNT; p++) {
+		g_acc[p].active = any_active;
+		g_acc[p].congestion = worst_congestion;
+		g_acc[p].total_bytes += sum_bytes;
+		snap.by_policy[p] = g_acc[p];
+	}
+}
+
+// ------------------------ Sampling ------------------------
+// Returns false when there is nothing to poll until the next event
+static bool sample_once(void)
+{
+	OutputStatsSnapshot snap;
+	snap.timestamp_ns = os_gettime_ns();
+
+	const int state = g_stream_state.load(std::memory_order_acquire);
+	snap.stream_state = state;
+
+	PolicyStats &streaming = snap.by_policy[OUTPUT_POLICY_STREAMING];
+	streaming.active = state != STREAM_STATE_IDLE;
+	if (state == STREAM_STATE_ACTIVE) {
+		std::lock_guard<std::mutex> lock(g_stream_mutex);
+		if (obs_output_t *out = g_stream_output) {
+			// Network dropped/total frames
+			streaming.dropped = (uint64_t)obs_output_get_frames_dropped(out);
+			streaming.total = (uint64_t)obs_output_get_total_frames(out);
+			// Early-warning inputs
+			streaming.congestion = obs_output_get_congestion(out);
+			streaming.total_bytes = obs_output_get_total_bytes(out);
+		}
+	}
+
+	// Encoder overload and rendering lag, read in the same pass
+	if (video_t *video = obs_get_video()) {
+		snap.encoder.total = video_output_get_total_frames(video);
+		snap.encoder.dropped = video_output_get_skipped_frames(video);
+	}
+	snap.render.total = obs_get_total_frames();
+	snap.render.dropped = obs_get_lagged_frames();
+
+	const bool track_all = g_enum_users.load(std::memory_order_relaxed) > 0;
+	if (track_all) {
+		if (snap.timestamp_ns - g_last_enum_ns >= kEnumIntervalNs) {
+			obs_enum_outputs(enum_active_output, nullptr);
+			g_last_enum_ns = snap.timestamp_ns;
+		}
+		sample_tracked(snap);
+	} else if (g_last_enum_ns) {
+		clear_tracked();
+	}
+	publish(snap);
+	return state != STREAM_STATE_IDLE || track_all;
+}
+
+static void sampler_thread(void)
+{
+	os_set_thread_name("online-status: stats sampler");
+
+	std::unique_lock<std::mutex> lock(g_wake_mutex);
+	while (!g_stop) {
+		g_kick = false;
+		lock.unlock();
+		const bool busy = sample_once();
+		lock.lock();
+
+		// Idle: sleep until a streaming event, a policy change or stop
+		if (busy) {
+			const auto interval = std::chrono::milliseconds(g_interval_ms.load(std::memory_order_relaxed));
+			g_wake.wait_for(lock, interval, [] { return g_stop || g_kick; });
+		} else {
+			g_wake.wait(lock, [] { return g_stop || g_kick; });
+		}
+	}
+}
+
+static void stop_thread(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(g_wake_mutex);
+		g_stop = true;
+	}
+	g_wake.notify_all();
+	if (g_thread.joinable())
+		g_thread.join();
+	clear_tracked();
+	detach_streaming_output();
+	g_stream_state.store(STREAM_STATE_IDLE, std::memory_order_relaxed);
+
+	// Readers see "not streaming" once the sampler is gone
+	publish(OutputStatsSnapshot{});
+}
+
+static void on_frontend_event(enum obs_frontend_event event, void *)
+{
+	switch (event) {
+	case OBS_FRONTEND_EVENT_STREAMING_STARTING:
+		// Connect early so the output's own start signal is not missed
+		attach_streaming_output();
+		break;
+	case OBS_FRONTEND_EVENT_STREAMING_STARTED:
+		attach_streaming_output();
+		set_stream_state(STREAM_STATE_ACTIVE);
+		break;
+	case OBS_FRONTEND_EVENT_STREAMING_STOPPED:
+		detach_streaming_output();
+		set_stream_state(STREAM_STATE_IDLE);
+		break;
+	case OBS_FRONTEND_EVENT_EXIT:
+		// The frontend tears down its outputs before modules unload; stop touching them on exit
+		stop_thread();
+		break;
+	default:
+		break;
+	}
+}
+
+// ------------------------ Lifetime ------------------------
+void online_status_sampler_start(void)
+{
+	if (g_thread.joinable())
+		return;
+	g_stop = false;
+	g_kick = false;
+	g_thread = std::thread(sampler_thread);
+	obs_frontend_add_event_callback(on_frontend_event, nullptr);
+}
+
+void online_status_sampler_stop(void)
+{
+	obs_frontend_remove_event_callback(on_frontend_event, nullptr);
+	stop_thread();
+}
+
+void online_status_sampler_set_interval_ms(uint32_t interval_ms)
+{
+	if (interval_ms < kMinIntervalMs)
+		interval_ms = kMinIntervalMs;
+	if (interval_ms > kMaxIntervalMs)
+		interval_ms = kMaxIntervalMs;
+	g_interval_ms.store(interval_ms, std::memory_order_relaxed);
+}
+
+void online_status_sampler_track_all_outputs(bool enable)
+{
+	g_enum_users.fetch_add(enable ? 1 : -1, std::memory_order_relaxed);
+	kick();
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <obs-module.h>
+#include <stdint.h>
+#include "core/drop_detector.hpp"
+
+// Which outputs a source watches and how their drops are combined
+enum OutputPolicy {
+	OUTPUT_POLICY_STREAMING = 0, // frontend streaming output only
+	OUTPUT_POLICY_WORST = 1,     // all active outputs, the one with the highest drop % per sample
+	OUTPUT_POLICY_WEIGHTED = 2,  // all active outputs, drops and frames summed
+	OUTPUT_POLICY_ANY = 3,       // all active outputs, any drop counts as a fully dropped sample
+	OUTPUT_POLICY_COUNT
+};
+
+// Streaming output lifecycle, driven by frontend events and output signals
+enum StreamState {
+	STREAM_STATE_IDLE = 0,         // not streaming
+	STREAM_STATE_ACTIVE = 1,       // streaming output started
+	STREAM_STATE_RECONNECTING = 2, // output lost the connection and is retrying
+};
+
+// Frame counters for one policy. The streaming policy reports the raw output counters;
+// the all-output policies report monotonic accumulators built from per-output deltas.
+struct PolicyStats {
+	bool active = false; // at least one watched output is active
+	uint64_t total = 0;
+	uint64_t dropped = 0;
+	float congestion = 0.0f;  // obs_output_get_congestion (worst output for all-output policies)
+	uint64_t total_bytes = 0; // obs_output_get_total_bytes (summed deltas for all-output policies)
+};
+
+// Immutable copy of the output stats, published by the module-level sampler
+struct OutputStatsSnapshot {
+	uint64_t seq = 0;          // publish counter (0 = nothing sampled yet)
+	uint64_t timestamp_ns = 0; // os_gettime_ns() at sample time
+	PolicyStats by_policy[OUTPUT_POLICY_COUNT];
+
+	int stream_state = STREAM_STATE_IDLE; // StreamState of the streaming output
+
+	// Pipeline counters, not tied to an output
+	FrameCounters encoder; // video output frames / skipped (encoder overload)
+	FrameCounters render;  // rendered frames / lagged (rendering lag)
+};
+
+// Sampler lifetime (obs_module_load / obs_module_unload)
+void online_status_sampler_start(void);
+void online_status_sampler_stop(void);
+
+// Sampling interval, shared by every Online Status source
+void online_status_sampler_set_interval_ms(uint32_t interval_ms);
+
+// Output enumeration only runs while at least one source uses an all-output policy
+void online_status_sampler_track_all_outputs(bool enable);
+
+// Copy the latest snapshot without locking; false if nothing was published yet
+bool online_status_sampler_read(OutputStatsSnapshot *out);
+
+// Seq of the newest snapshot (0 = nothing published); lets idle sources skip the copy.
+// The sampler stops publishing while nothing is streaming, so this stays put when idle.
+uint64_t online_status_sampler_seq(void);
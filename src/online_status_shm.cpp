@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_shm.hpp"
+#include "core/status_block.hpp"
+#include <obs-module.h>
+#include <stdio.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/*
+    Sources take an entry when they are created, whether or not publishing is on. The block
+    is created the first time publishing is turned on and stays mapped until unload, so a
+    tick that raced with turning it off still writes into valid memory. Turning publishing
+    back on or renaming a source bumps g_gen, which makes every source rewrite its entry
+    with its name. Sources created while every entry is taken have none (index -1) and are
+    counted in the header's overflow field instead.
+*/
+
+struct SourceStatus {
+	int index = -1;   // entry in the block, fixed for the source's lifetime; -1 = none
+	std::string name; // g_mutex
+
+	// Graphics thread only
+	StatusValues written;     // what the entry holds
+	uint32_t written_gen = 0; // g_gen the entry was written under
+	uint32_t hidden_gen = 0;  // g_gen the entry was marked unused under, 0 = shown
+	uint32_t state = STATUS_UNUSED;
+	uint64_t episode = 0;
+	uint64_t incident_seq = 0;
+};
+
+static std::mutex g_mutex; // g_sources, names and the block
+static SourceStatus *g_sources[kStatusEntryCount];
+static StatusBlock g_block;
+static bool g_block_open = false;
+static uint32_t g_overflow = 0; // sources without an entry
+static std::atomic<StatusEntry *> g_entries{nullptr}; // set while publishing
+static std::atomic<uint32_t> g_gen{1};
+
+// ------------------------ Graphics thread ------------------------
+static uint32_t status_state(const DropDetector *det, const DropDetectorConfig *cfg, bool streaming)
+{
+	if (cfg && drop_detector_reconnecting_on(det, cfg))
+		return STATUS_RECONNECTING;
+	if (det->auto_visible)
+		return STATUS_DROPPING;
+	if (det->degrading_visible)
+		return STATUS_DEGRADING;
+	if (det->stable_visible)
+		return STATUS_STABLE;
+	return streaming ? STATUS_OK : STATUS_IDLE;
+}
+
+static inline bool same_values(const StatusValues &a, const StatusValues &b)
+{
+	return a.state == b.state && a.cause == b.cause && a.drop_pct == b.drop_pct && a.episode == b.episode &&
+	       a.incident_seq == b.incident_seq;
+}
+
+void online_status_shm_tick(SourceStatus *status, const DropDetector *det, const DropDetectorConfig *cfg,
+			    bool streaming, uint64_t incident_seq)
+{
+	StatusEntry *entries = g_entries.load(std::memory_order_acquire);
+	if (!status || status->index < 0 || !entries)
+		return;
+	status->hidden_gen = 0;
+
+	// Episodes count like the alerts of the metrics exporter: one per stretch of an alert
+	const uint32_t state = status_state(det, cfg, streaming);
+	const bool alert = state == STATUS_DROPPING || state == STATUS_DEGRADING || state == STATUS_RECONNECTING;
+	if (alert && state != status->state)
+		status->episode++;
+	status->state = state;
+	if (incident_seq)
+		status->incident_seq = incident_seq;
+
+	StatusValues values;
+	values.state = state;
+	values.cause = state == STATUS_DROPPING ? (uint32_t)det->cause : (uint32_t)DROP_CAUSE_NONE;
+	const int pct_cause = det->cause < DROP_CAUSE_COUNT ? det->cause : DROP_CAUSE_NETWORK;
+	values.drop_pct = (float)det->signals[pct_cause].pct;
+	values.episode = status->episode;
+	values.incident_seq = status->incident_seq;
+
+	const uint32_t gen = g_gen.load(std::memory_order_relaxed);
+	if (gen == status->written_gen && same_values(values, status->written))
+		return;
+
+	// The name only changes on the UI thread; never wait for it here, a later tick retries
+	char name[sizeof(StatusEntry::name)];
+	bool with_name = false;
+	if (gen != status->written_gen) {
+		std::unique_lock<std::mutex> lock(g_mutex, std::try_to_lock);
+		if (lock.owns_lock()) {
+			snprintf(name, sizeof(name), "%s", status->name.c_str());
+			with_name = true;
+		}
+	}
+	if (!status_entry_write(&entries[status->index], &values, with_name ? name : nullptr))
+		return;
+	status->written = values;
+	if (with_name)
+		status->written_gen = gen;
+}
+
+void online_status_shm_hide(SourceStatus *status)
+{
+	StatusEntry *entries = g_entries.load(std::memory_order_acquire);
+	const uint32_t gen = g_gen.load(std::memory_order_relaxed);
+	if (!status || status->index < 0 || !entries || status->hidden_gen == gen)
+		return;
+	const StatusValues unused;
+	if (!status_entry_write(&entries[status->index], &unused, ""))
+		return;
+	status->written = unused;
+	status->state = STATUS_UNUSED;
+	status->hidden_gen = gen;
+	// Shown again with its name by the next tick
+	status->written_gen = 0;
+}
+
+// ------------------------ UI thread ------------------------
+// Writers are the source's own tick and the UI thread; a held entry is free again within a
+// few stores (g_mutex held)
+static void write_entry(int index, const StatusValues *values, const char *name)
+{
+	StatusEntry *entries = g_entries.load(std::memory_order_relaxed);
+	if (!entries)
+		return;
+	while (!status_entry_write(&entries[index], values, name))
+		std::this_thread::yield();
+}
+
+static void publish_overflow(void)
+{
+	if (g_block_open)
+		g_block.header->overflow.store(g_overflow, std::memory_order_relaxed);
+}
+
+SourceStatus *online_status_shm_register(const char *name)
+{
+	std::lock_guard<std::mutex> lock(g_mutex);
+	auto *status = new SourceStatus();
+	status->name = name ? name : "";
+	for (uint32_t i = 0; i < kStatusEntryCount; i++) {
+		if (g_sources[i])
+			continue;
+		status->index = (int)i;
+		g_sources[i] = status;
+		return status;
+	}
+	g_overflow++;
+	publish_overflow();
+	// Once per session; scenes with hundreds of copies would flood the log otherwise
+	static bool warned = false;
+	if (!warned)
+		blog(LOG_WARNING,
+		     "[online-status] More than %u sources; '%s' and later ones are not in the status block "
+		     "(counted in its overflow field)",
+		     kStatusEntryCount, status->name.c_str());
+	warned = true;
+	return status;
+}
+
+void online_status_shm_unregister(SourceStatus *status)
+{
+	if (!status)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		if (status->index < 0) {
+			g_overflow--;
+			publish_overflow();
+		} else {
+			g_sources[status->index] = nullptr;
+			const StatusValues unused;
+			write_entry(status->index, &unused, "");
+		}
+	}
+	delete status;
+}
+
+void online_status_shm_rename(SourceStatus *status, const char *name)
+{
+	if (!status)
+		return;
+	std::lock_guard<std::mutex> lock(g_mutex);
+	status->name = name ? name : "";
+	// Make the next tick write even though its values did not change
+	g_gen.fetch_add(1, std::memory_order_relaxed);
+}
+
+void online_status_shm_configure(bool enabled)
+{
+	std::lock_guard<std::mutex> lock(g_mutex);
+	if (enabled == (g_entries.load(std::memory_order_relaxed) != nullptr))
+		return;
+	if (!enabled) {
+		g_entries.store(nullptr, std::memory_order_release);
+		g_block.header->active.store(0, std::memory_order_release);
+		blog(LOG_INFO, "[online-status] Status block publishing stopped");
+		return;
+	}
+
+	if (!g_block_open) {
+		g_block_open = status_block_create(&g_block);
+		if (!g_block_open) {
+			blog(LOG_WARNING, "[online-status] Could not create the shared memory status block");
+			return;
+		}
+	}
+	g_gen.fetch_add(1, std::memory_order_relaxed);
+	g_entries.store(g_block.entries, std::memory_order_release);
+	// Entries of sources that went away while publishing was off still hold their last state
+	const StatusValues unused;
+	for (uint32_t i = 0; i < kStatusEntryCount; i++) {
+		if (!g_sources[i])
+			write_entry((int)i, &unused, "");
+	}
+	publish_overflow();
+	g_block.header->active.store(1, std::memory_order_release);
+	blog(LOG_INFO, "[online-status] Publishing status in shared memory");
+}
+
+void online_status_shm_stop(void)
+{
+	std::lock_guard<std::mutex> lock(g_mutex);
+	g_entries.store(nullptr, std::memory_order_release);
+	if (g_block_open)
+		status_block_close(&g_block, true);
+	g_block_open = false;
+}
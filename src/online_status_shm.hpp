@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include "core/drop_detector.hpp"
+
+// Optional live status in shared memory for external readers, see core/status_block.hpp.
+// Each source owns one entry; its tick rewrites the entry only when a value changed, so a
+// steady state costs a few compares and an idle module a single atomic load.
+struct SourceStatus;
+
+// UI thread: per-source entry, named after the source. Once every entry is taken the source
+// only counts towards the block's overflow field.
+SourceStatus *online_status_shm_register(const char *name);
+void online_status_shm_unregister(SourceStatus *status);
+void online_status_shm_rename(SourceStatus *status, const char *name);
+
+// Publishing is shared by every Online Status source; the last edited source wins
+void online_status_shm_configure(bool enabled);
+
+// Graphics thread, after the detector and incident tracking ticked. incident_seq is the
+// record of the watched output's open episode, 0 if none.
+void online_status_shm_tick(SourceStatus *status, const DropDetector *det, const DropDetectorConfig *cfg,
+			    bool streaming, uint64_t incident_seq);
+
+// Graphics thread: mark the entry unused until the next tick (a linked member; its group has
+// an entry of its own)
+void online_status_shm_hide(SourceStatus *status);
+
+// obs_module_unload: remove the block
+void online_status_shm_stop(void);
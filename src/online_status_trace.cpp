@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "online_status_trace.hpp"
+#include <obs-module.h>
+#include <util/bmem.h>
+#include <util/platform.h>
+#include <stdio.h>
+#include <time.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+/*
+    Events go into a ring at a position taken with one fetch_add, so any thread can record
+    without locks and the newest kTraceCapacity events survive. Each event carries its
+    position as a stamp, written last; a dump that finds a different stamp skips the event
+    as overwritten or still being written. Positions only grow, so stamps stay unique across
+    recordings. The ring stays allocated until unload, so a call that raced with turning
+    tracing off still writes into valid memory.
+*/
+
+const char *const kTraceScopeNames[TRACE_SCOPE_COUNT] = {
+	"online_status_video_tick",
+	"online_status_video_render",
+	"online_status_update",
+	"online_status_child_update",
+};
+
+// Event names in the trace
+static const char *const kEventNames[TRACE_SCOPE_COUNT] = {"tick", "render", "update", "child update"};
+
+static constexpr uint64_t kTraceCapacity = 1 << 16; // 2 MiB of events
+
+struct TraceEvent {
+	std::atomic<uint64_t> stamp; // position + 1 once complete, 0 = never written
+	std::atomic<uint64_t> start_ns;
+	std::atomic<uint32_t> dur_ns;
+	std::atomic<uint32_t> track; // TraceTrack::id, 0 = none
+	std::atomic<uint32_t> scope;
+	uint32_t reserved;
+};
+static_assert(sizeof(TraceEvent) == 32, "keep events compact");
+
+struct TraceTrack {
+	uint32_t id = 0;
+	std::string name; // g_mutex
+};
+
+static std::mutex g_mutex; // tracks, names and the ring allocation
+static std::set<TraceTrack *> g_tracks;
+static std::map<uint32_t, std::string> g_names; // every track seen by the current recording
+static uint32_t g_next_track = 1;
+static TraceEvent *g_ring = nullptr;
+static uint64_t g_first_pos = 0;                     // position the current recording started at
+static uint64_t g_start_ns = 0;                      // and its time, 0 on the timeline
+static std::atomic<TraceEvent *> g_events{nullptr}; // set while tracing
+static std::atomic<uint64_t> g_next_pos{0};
+
+// ------------------------ Recording ------------------------
+uint64_t online_status_trace_begin(void)
+{
+	return g_events.load(std::memory_order_relaxed) ? os_gettime_ns() : 0;
+}
+
+void online_status_trace_end(TraceTrack *track, int scope, uint64_t start_ns)
+{
+	TraceEvent *events = g_events.load(std::memory_order_acquire);
+	if (!events)
+		return;
+	const uint64_t end_ns = os_gettime_ns();
+	const uint64_t pos = g_next_pos.fetch_add(1, std::memory_order_relaxed);
+	TraceEvent &e = events[pos & (kTraceCapacity - 1)];
+	e.stamp.store(0, std::memory_order_relaxed);
+	// Field stores must not become visible before the stamp was cleared
+	std::atomic_thread_fence(std::memory_order_release);
+	e.start_ns.store(start_ns, std::memory_order_relaxed);
+	e.dur_ns.store((uint32_t)(end_ns - start_ns), std::memory_order_relaxed);
+	e.track.store(track ? track->id : 0, std::memory_order_relaxed);
+	e.scope.store((uint32_t)scope, std::memory_order_relaxed);
+	e.stamp.store(pos + 1, std::memory_order_release);
+}
+
+// ------------------------ Tracks ------------------------
+TraceTrack *online_status_trace_register(const char *name)
+{
+	auto *track = new TraceTrack();
+	std::lock_guard<std::mutex> lock(g_mutex);
+	track->id = g_next_track++;
+	track->name = name ? name : "";
+	g_tracks.insert(track);
+	g_names[track->id] = track->name;
+	return track;
+}
+
+// Its events stay in the ring, so the name stays until the next recording starts
+void online_status_trace_unregister(TraceTrack *track)
+{
+	if (!track)
+		return;
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		g_tracks.erase(track);
+	}
+	delete track;
+}
+
+void online_status_trace_rename(TraceTrack *track, const char *name)
+{
+	if (!track)
+		return;
+	std::lock_guard<std::mutex> lock(g_mutex);
+	track->name = name ? name : "";
+	g_names[track->id] = track->name;
+}
+
+void online_status_trace_configure(bool enabled)
+{
+	std::lock_guard<std::mutex> lock(g_mutex);
+	if (enabled == (g_events.load(std::memory_order_relaxed) != nullptr))
+		return;
+	if (!enabled) {
+		g_events.store(nullptr, std::memory_order_release);
+		blog(LOG_INFO, "[online-status] Tracing stopped");
+		return;
+	}
+
+	if (!g_ring)
+		g_ring = new TraceEvent[kTraceCapacity]();
+	g_first_pos = g_next_pos.load(std::memory_order_relaxed);
+	g_start_ns = os_gettime_ns();
+	g_names.clear();
+	for (const TraceTrack *track : g_tracks)
+		g_names[track->id] = track->name;
+	g_events.store(g_ring, std::memory_order_release);
+	blog(LOG_INFO, "[online-status] Tracing started (last %llu calls are kept)", (unsigned long long)kTraceCapacity);
+}
+
+// ------------------------ Chrome trace JSON ------------------------
+static void append_json_string(std::string &out, const std::string &value)
+{
+	out += '"';
+	for (unsigned char ch : value) {
+		if (ch == '\\' || ch == '"') {
+			out += '\\';
+			out += (char)ch;
+		} else if (ch < 0x20) {
+			char esc[8];
+			snprintf(esc, sizeof(esc), "\\u%04x", ch);
+			out += esc;
+		} else {
+			out += (char)ch;
+		}
+	}
+	out += '"';
+}
+
+// Events of the current recording that are complete; one track (tid) per source
+static size_t append_events(std::string &out)
+{
+	const uint64_t next = g_next_pos.load(std::memory_order_acquire);
+	uint64_t pos = g_first_pos;
+	if (next - pos > kTraceCapacity)
+		pos = next - kTraceCapacity;
+
+	size_t count = 0;
+	char buf[160];
+	for (; pos < next; pos++) {
+		const TraceEvent &e = g_ring[pos & (kTraceCapacity - 1)];
+		if (e.stamp.load(std::memory_order_acquire) != pos + 1)
+			continue;
+		const uint64_t start_ns = e.start_ns.load(std::memory_order_relaxed);
+		const uint32_t dur_ns = e.dur_ns.load(std::memory_order_relaxed);
+		const uint32_t track = e.track.load(std::memory_order_relaxed);
+		const uint32_t scope = e.scope.load(std::memory_order_relaxed);
+		// Field loads must complete before the stamp is checked again
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (e.stamp.load(std::memory_order_relaxed) != pos + 1 || scope >= TRACE_SCOPE_COUNT)
+			continue;
+		const double ts_us = (double)(int64_t)(start_ns - g_start_ns) / 1000.0;
+		snprintf(buf, sizeof(buf),
+			 ",\n{\"name\":\"%s\",\"cat\":\"online-status\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+			 "\"dur\":%.3f}",
+			 kEventNames[scope], track, ts_us, (double)dur_ns / 1000.0);
+		out += buf;
+		count++;
+	}
+	return count;
+}
+
+char *online_status_trace_dump(void)
+{
+	std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+			   "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Online Status\"}}";
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		if (!g_ring || !append_events(json))
+			return nullptr;
+		char buf[96];
+		for (const auto &[id, name] : g_names) {
+			snprintf(buf, sizeof(buf), ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,", id);
+			json += buf;
+			json += "\"args\":{\"name\":";
+			append_json_string(json, name);
+			json += "}}";
+		}
+	}
+	json += "\n]}\n";
+
+	char file[64];
+	const time_t now = time(nullptr);
+	struct tm local;
+#ifdef _WIN32
+	localtime_s(&local, &now);
+#else
+	localtime_r(&now, &local);
+#endif
+	strftime(file, sizeof(file), "trace-%Y%m%d-%H%M%S.json", &local);
+	char *dir = obs_module_config_path("");
+	char *path = obs_module_config_path(file);
+	if (dir)
+		os_mkdirs(dir);
+	bfree(dir);
+	if (path && !os_quick_write_utf8_file_safe(path, json.data(), json.size(), false, "tmp", nullptr)) {
+		blog(LOG_WARNING, "[online-status] Could not write the trace to %s", path);
+		bfree(path);
+		return nullptr;
+	}
+	return path;
+}
+
+void online_status_trace_stop(void)
+{
+	std::lock_guard<std::mutex> lock(g_mutex);
+	g_events.store(nullptr, std::memory_order_release);
+	delete[] g_ring;
+	g_ring = nullptr;
+}
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <util/profiler.h>
+
+// Profiler scopes and an optional tracer. Every scope always shows up in OBS's own profiler
+// (Help -> Log Files, or the profiler log written at exit). While tracing is turned on, each
+// call is also recorded as one event on its source's track: a fixed ring of recent events
+// that is allocated when tracing starts, so recording is a clock read and a few stores. The
+// ring is written out as Chrome trace-event JSON on demand (chrome://tracing, Perfetto).
+struct TraceTrack;
+
+// Traced paths
+enum TraceScopeId {
+	TRACE_TICK = 0,
+	TRACE_RENDER = 1,
+	TRACE_UPDATE = 2,
+	TRACE_CHILD_UPDATE = 3, // settings pushed into a text child
+	TRACE_SCOPE_COUNT
+};
+
+// UI thread: per-source track, named after the source
+TraceTrack *online_status_trace_register(const char *name);
+void online_status_trace_unregister(TraceTrack *track);
+void online_status_trace_rename(TraceTrack *track, const char *name);
+
+// Tracing is shared by every Online Status source; the last edited source wins.
+// Turning it on starts a new, empty recording.
+void online_status_trace_configure(bool enabled);
+
+// Write the recorded events to a new JSON file in the plugin config directory. Returns the
+// path (bfree it), or nullptr when nothing was recorded or the file could not be written.
+char *online_status_trace_dump(void);
+
+// Any thread: start time of a call, 0 while tracing is off
+uint64_t online_status_trace_begin(void);
+void online_status_trace_end(TraceTrack *track, int scope, uint64_t start_ns);
+
+// Profiler names; OBS matches scopes by pointer, so both ends use these
+extern const char *const kTraceScopeNames[TRACE_SCOPE_COUNT];
+
+// OBS profiler scope plus, while tracing, one event on the track
+struct TraceScope {
+	TraceScope(TraceTrack *track_, int scope_) : track(track_), scope(scope_)
+	{
+		profile_start(kTraceScopeNames[scope]);
+		start_ns = online_status_trace_begin();
+	}
+	~TraceScope()
+	{
+		if (start_ns)
+			online_status_trace_end(track, scope, start_ns);
+		profile_end(kTraceScopeNames[scope]);
+	}
+	TraceScope(const TraceScope &) = delete;
+	TraceScope &operator=(const TraceScope &) = delete;
+
+	TraceTrack *track;
+	int scope;
+	uint64_t start_ns = 0;
+};
+
+// obs_module_unload
+void online_status_trace_stop(void);
@@ -18,6 +18,15 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #include <obs-module.h>
 #include <plugin-support.h>
+#include "online_status_anim.hpp"
+#include "online_status_audio.hpp"
+#include "online_status_incidents.hpp"
+#include "online_status_loader.hpp"
+#include "online_status_metrics.hpp"
+#include "online_status_recorder.hpp"
+#include "online_status_sampler.hpp"
+#include "online_status_shm.hpp"
+#include "online_status_trace.hpp"
 
 OBS_DECLARE_MODULE()
 OBS_MODULE_USE_DEFAULT_LOCALE(PLUGIN_NAME, "en-US")
@@ -27,11 +36,22 @@ void register_online_status_source(void);
 bool obs_module_load(void)
 {
 	obs_log(LOG_INFO, "plugin loaded successfully (version %s)", PLUGIN_VERSION);
+	online_status_incidents_open();
+	online_status_audio_init();
 	register_online_status_source();
+	online_status_sampler_start();
 	return true;
 }
 
 void obs_module_unload(void)
 {
+	online_status_metrics_stop();
+	online_status_shm_stop();
+	online_status_trace_stop();
+	online_status_recorder_stop();
+	online_status_sampler_stop();
+	online_status_loader_stop();
+	online_status_anim_unload();
+	online_status_incidents_close();
 	obs_log(LOG_INFO, "plugin unloaded");
 }
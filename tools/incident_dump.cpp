@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Offline reader for the incident log (incidents.bin in the plugin config directory):
+// lists the recorded episodes oldest first and/or prints a summary.
+#include "core/incident_log.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+static const char *const kKindNames[INCIDENT_KIND_COUNT] = {"dropping", "reconnecting"};
+static const char *const kCauseNames[DROP_CAUSE_COUNT] = {"network", "encoder", "render"};
+
+static const char *kind_name(int kind)
+{
+	return kind >= 0 && kind < INCIDENT_KIND_COUNT ? kKindNames[kind] : "?";
+}
+
+static const char *cause_name(int cause)
+{
+	return cause >= 0 && cause < DROP_CAUSE_COUNT ? kCauseNames[cause] : "-";
+}
+
+static void format_time(char *buf, size_t size, uint64_t unix_ms)
+{
+	const time_t t = (time_t)(unix_ms / 1000);
+	struct tm tm_local;
+#ifdef _WIN32
+	localtime_s(&tm_local, &t);
+#else
+	localtime_r(&t, &tm_local);
+#endif
+	strftime(buf, size, "%Y-%m-%d %H:%M:%S", &tm_local);
+}
+
+static void format_duration(char *buf, size_t size, const IncidentRecord &rec)
+{
+	if (!rec.end_ms) {
+		snprintf(buf, size, "open");
+		return;
+	}
+	const uint64_t ms = rec.end_ms >= rec.start_ms ? rec.end_ms - rec.start_ms : 0;
+	snprintf(buf, size, "%llu:%02llu.%01llu", (unsigned long long)(ms / 60000),
+		 (unsigned long long)(ms / 1000 % 60), (unsigned long long)(ms / 100 % 10));
+}
+
+// Copy of a fixed-size label; the writer NUL-terminates, a torn record might not
+static void label(char *buf, size_t size, const char *src, size_t src_size)
+{
+	const size_t n = std::min(size - 1, strnlen(src, src_size));
+	memcpy(buf, src, n);
+	buf[n] = '\0';
+}
+
+static void dump(const std::vector<IncidentRecord> &records)
+{
+	printf("%8s  %-19s  %9s  %-12s  %-7s  %7s  %17s  %-12s  %s\n", "seq", "start", "duration", "kind", "cause",
+	       "peak %", "dropped/total", "output", "source");
+	for (const IncidentRecord &rec : records) {
+		char start[32], duration[32], frames[40];
+		char output[sizeof(rec.output) + 1], source[sizeof(rec.source) + 1];
+		format_time(start, sizeof(start), rec.start_ms);
+		format_duration(duration, sizeof(duration), rec);
+		label(output, sizeof(output), rec.output, sizeof(rec.output));
+		label(source, sizeof(source), rec.source, sizeof(rec.source));
+		snprintf(frames, sizeof(frames), "%llu/%llu", (unsigned long long)rec.dropped_frames,
+			 (unsigned long long)rec.total_frames);
+		printf("%8llu  %-19s  %9s  %-12s  %-7s  %7.2f  %17s  %-12s  %s\n", (unsigned long long)rec.seq, start,
+		       duration, kind_name(rec.kind), rec.kind == INCIDENT_DROPPING ? cause_name(rec.cause) : "-",
+		       (double)rec.peak_pct, frames, output, source);
+	}
+}
+
+static void summarize(const std::vector<IncidentRecord> &records)
+{
+	uint64_t count[INCIDENT_KIND_COUNT] = {};
+	uint64_t total_ms[INCIDENT_KIND_COUNT] = {};
+	uint64_t by_cause[DROP_CAUSE_COUNT] = {};
+	uint64_t dropped = 0, open = 0, longest_ms = 0;
+	const IncidentRecord *worst = nullptr;
+	const IncidentRecord *longest = nullptr;
+
+	for (const IncidentRecord &rec : records) {
+		if (rec.kind >= INCIDENT_KIND_COUNT)
+			continue;
+		count[rec.kind]++;
+		if (!rec.end_ms) {
+			open++;
+		} else if (rec.end_ms >= rec.start_ms) {
+			const uint64_t ms = rec.end_ms - rec.start_ms;
+			total_ms[rec.kind] += ms;
+			if (ms > longest_ms) {
+				longest_ms = ms;
+				longest = &rec;
+			}
+		}
+		if (rec.kind != INCIDENT_DROPPING)
+			continue;
+		if (rec.cause < DROP_CAUSE_COUNT)
+			by_cause[rec.cause]++;
+		dropped += rec.dropped_frames;
+		if (!worst || rec.peak_pct > worst->peak_pct)
+			worst = &rec;
+	}
+
+	char when[32];
+	printf("episodes:        %zu", records.size());
+	if (!records.empty()) {
+		format_time(when, sizeof(when), records.front().start_ms);
+		printf(" (since %s)", when);
+	}
+	printf("\n");
+	for (int k = 0; k < INCIDENT_KIND_COUNT; k++)
+		printf("  %-13s  %6llu  total %.1f s\n", kKindNames[k], (unsigned long long)count[k],
+		       (double)total_ms[k] / 1000.0);
+	for (int c = 0; c < DROP_CAUSE_COUNT; c++) {
+		char name[32];
+		snprintf(name, sizeof(name), "dropping/%s", kCauseNames[c]);
+		printf("  %-16s  %3llu\n", name, (unsigned long long)by_cause[c]);
+	}
+	printf("dropped frames:  %llu\n", (unsigned long long)dropped);
+	if (worst) {
+		format_time(when, sizeof(when), worst->start_ms);
+		printf("worst peak:      %.2f %% at %s (seq %llu)\n", (double)worst->peak_pct, when,
+		       (unsigned long long)worst->seq);
+	}
+	if (longest) {
+		format_time(when, sizeof(when), longest->start_ms);
+		printf("longest:         %.1f s %s at %s (seq %llu)\n", (double)longest_ms / 1000.0,
+		       kind_name(longest->kind), when, (unsigned long long)longest->seq);
+	}
+	if (open)
+		printf("never closed:    %llu (OBS exited or crashed during the episode)\n", (unsigned long long)open);
+}
+
+static int usage(const char *argv0)
+{
+	fprintf(stderr, "usage: %s [--summary | --all] [--last N] <incidents.bin>\n", argv0);
+	fprintf(stderr, "  default lists every episode; --summary prints totals only, --all prints both\n");
+	return 2;
+}
+
+int main(int argc, char **argv)
+{
+	bool list = true, summary = false;
+	size_t last = 0;
+	const char *path = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--summary")) {
+			list = false;
+			summary = true;
+		} else if (!strcmp(argv[i], "--all")) {
+			list = summary = true;
+		} else if (!strcmp(argv[i], "--last") && i + 1 < argc) {
+			last = strtoull(argv[++i], nullptr, 10);
+		} else if (argv[i][0] == '-' || path) {
+			return usage(argv[0]);
+		} else {
+			path = argv[i];
+		}
+	}
+	if (!path)
+		return usage(argv[0]);
+
+	IncidentLog log;
+	if (!incident_log_open_readonly(&log, path)) {
+		fprintf(stderr, "%s: not an incident log\n", path);
+		return 1;
+	}
+
+	// Copy out the written slots, oldest first
+	std::vector<IncidentRecord> records;
+	for (uint32_t i = 0; i < log.header->capacity; i++) {
+		if (log.records[i].seq)
+			records.push_back(log.records[i]);
+	}
+	incident_log_close(&log);
+	std::sort(records.begin(), records.end(),
+		  [](const IncidentRecord &a, const IncidentRecord &b) { return a.seq < b.seq; });
+	if (last && records.size() > last)
+		records.erase(records.begin(), records.end() - (ptrdiff_t)last);
+
+	if (list)
+		dump(records);
+	if (list && summary)
+		printf("\n");
+	if (summary)
+		summarize(records);
+	return 0;
+}
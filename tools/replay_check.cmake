@@ -0,0 +1,16 @@
+# ctest helper: replay TRACE with REPLAY and compare the timeline with EXPECTED
+execute_process(
+  COMMAND "${REPLAY}" "${TRACE}"
+  OUTPUT_VARIABLE actual
+  RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${REPLAY} exited with ${result}")
+endif()
+
+file(READ "${EXPECTED}" expected)
+string(REPLACE "\r\n" "\n" actual "${actual}")
+string(REPLACE "\r\n" "\n" expected "${expected}")
+if(NOT actual STREQUAL expected)
+  message(FATAL_ERROR "Timeline differs from ${EXPECTED}:\n${actual}")
+endif()
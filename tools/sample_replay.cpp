@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Offline replay of a sample trace (samples-*.bin in the plugin config directory): feeds the
+// recorded ticks through the drop detector as fast as it can and prints when the overlay
+// would have changed. The timeline only depends on the trace and the options, so a stored
+// timeline of a real incident can be diffed against the output of a later build.
+#include "core/sample_trace.hpp"
+#include "core/status_block.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+static const char *const kStateNames[STATUS_STATE_COUNT] = {"-",         "idle",         "ok",    "dropping",
+							    "degrading", "reconnecting", "stable"};
+static const char *const kCauseNames[DROP_CAUSE_COUNT] = {"network", "encoder", "render"};
+
+// Settings to use instead of the recorded ones; NaN / -1 = keep the recorded value
+struct Overrides {
+	double threshold_pct = NAN;
+	double exit_pct = NAN;
+	long long window_ms = -1;
+	double hide_after_sec = NAN;
+	int adaptive = -1;
+	double quantile = NAN;
+	double learn_sec = NAN;
+	double min_pct = NAN;
+};
+
+static void apply_overrides(DropDetectorConfig *cfg, const Overrides &o)
+{
+	if (!std::isnan(o.threshold_pct))
+		cfg->drop_threshold_pct = o.threshold_pct;
+	if (!std::isnan(o.exit_pct))
+		cfg->drop_exit_threshold_pct = o.exit_pct;
+	// Same limits as the source settings
+	if (cfg->drop_exit_threshold_pct > cfg->drop_threshold_pct)
+		cfg->drop_exit_threshold_pct = cfg->drop_threshold_pct;
+	if (o.window_ms >= 0)
+		cfg->drop_window_ms = (uint32_t)(o.window_ms < 250 ? 250 : (o.window_ms > 10000 ? 10000 : o.window_ms));
+	if (!std::isnan(o.hide_after_sec))
+		cfg->hide_after_sec = (float)o.hide_after_sec;
+	if (o.adaptive >= 0)
+		cfg->adaptive = o.adaptive != 0;
+	if (!std::isnan(o.quantile))
+		cfg->baseline.quantile = o.quantile;
+	if (!std::isnan(o.learn_sec))
+		cfg->baseline.learn_sec = (float)o.learn_sec;
+	if (!std::isnan(o.min_pct))
+		cfg->baseline.min_pct = o.min_pct;
+}
+
+// What the source would show, in the order the plugin picks it
+static int overlay_state(const DropDetector *det, const DropDetectorConfig *cfg, bool streaming)
+{
+	if (drop_detector_reconnecting_on(det, cfg))
+		return STATUS_RECONNECTING;
+	if (det->auto_visible)
+		return STATUS_DROPPING;
+	if (det->degrading_visible)
+		return STATUS_DEGRADING;
+	if (det->stable_visible)
+		return STATUS_STABLE;
+	return streaming ? STATUS_OK : STATUS_IDLE;
+}
+
+static bool read_file(const char *path, std::vector<uint8_t> *data)
+{
+	FILE *f = fopen(path, "rb");
+	if (!f)
+		return false;
+	uint8_t buf[65536];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		data->insert(data->end(), buf, buf + n);
+	const bool ok = !ferror(f);
+	fclose(f);
+	return ok;
+}
+
+static int usage(const char *argv0)
+{
+	fprintf(stderr,
+		"usage: %s [options] <samples.bin>\n"
+		"  --threshold PCT   show at this drop %%       --exit PCT      keep showing at this drop %%\n"
+		"  --window MS       drop %% window             --hide SEC      hide after this long below exit\n"
+		"  --adaptive        learned threshold         --fixed         fixed threshold\n"
+		"  --quantile Q      adaptive percentile       --learn SEC     adaptive learning time\n"
+		"  --min PCT         adaptive floor\n"
+		"  Options replace the recorded settings; the timeline goes to stdout, the replay speed to stderr\n",
+		argv0);
+	return 2;
+}
+
+int main(int argc, char **argv)
+{
+	Overrides o;
+	const char *path = nullptr;
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		if (!strcmp(arg, "--adaptive")) {
+			o.adaptive = 1;
+		} else if (!strcmp(arg, "--fixed")) {
+			o.adaptive = 0;
+		} else if (!strcmp(arg, "--threshold") && has_value) {
+			o.threshold_pct = strtod(argv[++i], nullptr);
+		} else if (!strcmp(arg, "--exit") && has_value) {
+			o.exit_pct = strtod(argv[++i], nullptr);
+		} else if (!strcmp(arg, "--window") && has_value) {
+			o.window_ms = strtoll(argv[++i], nullptr, 10);
+		} else if (!strcmp(arg, "--hide") && has_value) {
+			o.hide_after_sec = strtod(argv[++i], nullptr);
+		} else if (!strcmp(arg, "--quantile") && has_value) {
+			o.quantile = strtod(argv[++i], nullptr);
+		} else if (!strcmp(arg, "--learn") && has_value) {
+			o.learn_sec = strtod(argv[++i], nullptr);
+		} else if (!strcmp(arg, "--min") && has_value) {
+			o.min_pct = strtod(argv[++i], nullptr);
+		} else if (arg[0] == '-' || path) {
+			return usage(argv[0]);
+		} else {
+			path = arg;
+		}
+	}
+	if (!path)
+		return usage(argv[0]);
+
+	std::vector<uint8_t> data;
+	SampleTraceReader reader;
+	if (!read_file(path, &data)) {
+		fprintf(stderr, "%s: cannot read\n", path);
+		return 1;
+	}
+	if (!sample_trace_reader_init(&reader, data.data(), data.size())) {
+		fprintf(stderr, "%s: not a sample trace\n", path);
+		return 1;
+	}
+
+	const time_t start = (time_t)(reader.start_ms / 1000);
+	struct tm local;
+#ifdef _WIN32
+	localtime_s(&local, &start);
+#else
+	localtime_r(&start, &local);
+#endif
+	char when[32];
+	strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", &local);
+	printf("# recorded %s\n", when);
+	printf("%10s  %-12s  %-7s  %8s  %11s\n", "time s", "state", "cause", "drop %", "threshold %");
+
+	DropDetector det;
+	DropDetectorConfig cfg;
+	apply_overrides(&cfg, o);
+	SampleTraceTick tick;
+	double t = 0.0;
+	uint64_t ticks = 0;
+	int state = STATUS_UNUSED;
+	int cause = DROP_CAUSE_NONE;
+	double state_sec[STATUS_STATE_COUNT] = {};
+	uint64_t episodes[STATUS_STATE_COUNT] = {};
+
+	const auto wall_start = std::chrono::steady_clock::now();
+	int result;
+	while ((result = sample_trace_read(&reader, &tick)) == SAMPLE_TRACE_READ_OK) {
+		// Idle time is spent in the state the source was in, which cannot have changed
+		t += tick.idle_sec;
+		if (state != STATUS_UNUSED)
+			state_sec[state] += tick.idle_sec;
+		if (tick.has_config) {
+			cfg = tick.config;
+			apply_overrides(&cfg, o);
+		}
+		// Same order as the plugin: new settings, output switch, test buttons, tick
+		if (tick.rebase)
+			drop_detector_rebase(&det);
+		if (tick.commands)
+			drop_detector_apply_commands(&det, &cfg, tick.commands);
+		drop_detector_tick(&det, &cfg, &tick.sample, tick.seconds);
+		t += tick.seconds;
+		ticks++;
+
+		const int next = overlay_state(&det, &cfg, tick.sample.active);
+		const int next_cause = next == STATUS_DROPPING ? det.cause : DROP_CAUSE_NONE;
+		state_sec[next] += tick.seconds;
+		if (next == state && next_cause == cause)
+			continue;
+		if (next != state)
+			episodes[next]++;
+		state = next;
+		cause = next_cause;
+		const int pct_cause = cause != DROP_CAUSE_NONE ? cause : DROP_CAUSE_NETWORK;
+		printf("%10.3f  %-12s  %-7s  %8.2f  %11.2f\n", t, kStateNames[state],
+		       cause != DROP_CAUSE_NONE ? kCauseNames[cause] : "-", det.signals[pct_cause].pct,
+		       drop_detector_threshold_pct(&det, &cfg, pct_cause));
+	}
+	const double wall_sec =
+		std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+	printf("# %llu ticks, %.3f s\n", (unsigned long long)ticks, t);
+	for (int s = STATUS_IDLE; s < STATUS_STATE_COUNT; s++)
+		printf("# %-12s  %6llu times  %10.3f s\n", kStateNames[s], (unsigned long long)episodes[s], state_sec[s]);
+	if (result == SAMPLE_TRACE_READ_TRUNCATED)
+		printf("# the last tick is cut off (%zu bytes)\n", reader.size - reader.pos);
+	fprintf(stderr, "replayed %.1f s of stream in %.1f ms (%.0fx real time)\n", t, wall_sec * 1000.0,
+		wall_sec > 0.0 ? t / wall_sec : 0.0);
+	return 0;
+}
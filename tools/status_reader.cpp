@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-2.0-or-later
+// Reader for the live status block the plugin publishes in shared memory (Advanced:
+// "Publish live status in shared memory"). Prints every source once, or with --watch a
+// line whenever a source changes. Doubles as an example for stream deck / tally tools.
+// A second OBS instance publishes under its pid; --pid selects that block.
+#include "core/drop_detector.hpp"
+#include "core/status_block.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+static const char *const kStateNames[STATUS_STATE_COUNT] = {"unused",       "idle",        "ok",    "dropping",
+							    "degrading",    "reconnecting", "stable"};
+static const char *const kCauseNames[DROP_CAUSE_COUNT] = {"network", "encoder", "render"};
+
+static const char *state_name(uint32_t state)
+{
+	return state < STATUS_STATE_COUNT ? kStateNames[state] : "?";
+}
+
+static const char *cause_name(uint32_t cause)
+{
+	return cause < DROP_CAUSE_COUNT ? kCauseNames[cause] : "-";
+}
+
+static void print_entry(uint32_t index, const StatusValues &v, const char *name)
+{
+	printf("%3u  %-12s  %-7s  %7.2f  %8llu  %8llu  %s\n", index, state_name(v.state), cause_name(v.cause),
+	       (double)v.drop_pct, (unsigned long long)v.episode, (unsigned long long)v.incident_seq, name);
+}
+
+static void print_heading(void)
+{
+	printf("%3s  %-12s  %-7s  %7s  %8s  %8s  %s\n", "#", "state", "cause", "drop %", "episode", "incident",
+	       "source");
+}
+
+static int usage(const char *argv0)
+{
+	fprintf(stderr, "usage: %s [--pid pid] [--watch [interval_ms]]\n", argv0);
+	fprintf(stderr, "  --pid reads the block of that OBS process (default: the first instance)\n");
+	fprintf(stderr, "  --watch prints a line whenever a source changes (default every 1 ms)\n");
+	return 2;
+}
+
+int main(int argc, char **argv)
+{
+	bool watch = false;
+	unsigned interval_ms = 1;
+	uint32_t pid = 0;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--pid") && i + 1 < argc) {
+			pid = (uint32_t)strtoul(argv[++i], nullptr, 10);
+		} else if (!strcmp(argv[i], "--watch")) {
+			watch = true;
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+				interval_ms = (unsigned)strtoul(argv[++i], nullptr, 10);
+		} else {
+			return usage(argv[0]);
+		}
+	}
+
+	StatusBlock block;
+	if (!status_block_open_readonly(&block, pid)) {
+		fprintf(stderr, "no status block (is OBS running with publishing turned on?)\n");
+		return 1;
+	}
+	const bool active = block.header->active.load(std::memory_order_acquire) != 0;
+	printf("publisher pid %u%s\n", block.header->pid, active ? "" : " (publishing turned off, values are stale)");
+	const uint32_t overflow = block.header->overflow.load(std::memory_order_relaxed);
+	if (overflow)
+		printf("%u sources have no entry (all %u are taken)\n", overflow, block.header->entry_count);
+	print_heading();
+
+	// Snapshot per entry; a read that keeps overlapping writes is retried on the next pass
+	const uint32_t count = block.header->entry_count;
+	StatusValues last[kStatusEntryCount] = {};
+	bool have[kStatusEntryCount] = {};
+	for (;;) {
+		for (uint32_t i = 0; i < count && i < kStatusEntryCount; i++) {
+			StatusValues v;
+			char name[32];
+			if (!status_entry_read(&block.entries[i], &v, name))
+				continue;
+			const bool changed = !have[i] || v.state != last[i].state || v.cause != last[i].cause ||
+					     v.drop_pct != last[i].drop_pct || v.episode != last[i].episode ||
+					     v.incident_seq != last[i].incident_seq;
+			if (changed && (v.state != STATUS_UNUSED || (have[i] && last[i].state != STATUS_UNUSED)))
+				print_entry(i, v, name);
+			last[i] = v;
+			have[i] = true;
+		}
+		if (!watch)
+			break;
+		fflush(stdout);
+		std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+	}
+	status_block_close(&block, false);
+	return 0;
+}